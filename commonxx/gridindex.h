@@ -0,0 +1,161 @@
+/*! \file gridindex.h
+ * \brief Linear index of the nodes of a regular parameter space grid.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Linear index of the nodes of a regular parameter space grid. The
+ * index is computed from the coordinates of a node alone, so it is
+ * available to the threads computing the nodes and results written in the
+ * order of completion can be sorted afterwards.
+ *
+
+ * ----
+ * This file is part of calex optimization.
+ *
+ * calex optimization is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * calex optimization is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with calex optimization.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <vector>
+#include <set>
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include <optimizexx/iterator.h>
+
+#ifndef _OPTIMIZE_COMMON_GRIDINDEX_H_
+#define _OPTIMIZE_COMMON_GRIDINDEX_H_
+
+namespace opt = optimize;
+
+/*!
+ * linear index of a grid node
+ *
+ * The index is row major with respect to the coordinates of a node, i.e.
+ * the last coordinate varies fastest. A coordinate is mapped to the nearest
+ * value of its axis.
+ *
+ * \tparam Tcoord coordinate type of the parameter space
+ */
+template <typename Tcoord>
+class GridIndex
+{
+  public:
+    /*!
+     * constructor
+     *
+     * \param axes values of the axes in the order of the node coordinates;
+     * each axis is sorted ascending
+     */
+    GridIndex(std::vector<std::vector<Tcoord>> const& axes) : Maxes(axes)
+    {
+      for (auto cit(Maxes.cbegin()); cit != Maxes.cend(); ++cit)
+      {
+        if (cit->empty()) { throw std::string("Empty grid axis."); }
+      }
+    }
+    //! number of nodes of the grid
+    size_t size() const
+    {
+      size_t retval = 1;
+      for (auto cit(Maxes.cbegin()); cit != Maxes.cend(); ++cit)
+      {
+        retval *= cit->size();
+      }
+      return retval;
+    }
+    //! index of the node with the coordinates passed
+    size_t operator()(std::vector<Tcoord> const& coordinates) const
+    {
+      if (coordinates.size() != Maxes.size())
+      {
+        throw std::string("Coordinates do not match grid dimension.");
+      }
+      size_t retval = 0;
+      for (size_t i=0; i<Maxes.size(); ++i)
+      {
+        std::vector<Tcoord> const& axis = Maxes[i];
+        size_t k = std::lower_bound(axis.begin(), axis.end(),
+            coordinates[i])-axis.begin();
+        if (k == axis.size() || (k > 0 &&
+              coordinates[i]-axis[k-1] < axis[k]-coordinates[i]))
+        {
+          --k;
+        }
+        retval = retval*axis.size()+k;
+      }
+      return retval;
+    }
+
+  private:
+    //! axis values
+    std::vector<std::vector<Tcoord>> Maxes;
+
+}; // class GridIndex
+
+/*!
+ * regular axis from \a start to \a end sampled with \a delta
+ *
+ * A tolerance of a millionth of \a delta keeps the upper boundary despite
+ * rounding errors.
+ */
+template <typename Tcoord>
+std::vector<Tcoord> regularAxis(Tcoord start, Tcoord end, Tcoord delta)
+{
+  if (0 >= delta) { throw std::string("Illegal axis interval."); }
+  std::vector<Tcoord> retval;
+  size_t const n = static_cast<size_t>(
+      std::floor((end-start)/delta+1e-6))+1;
+  for (size_t i=0; i<n; ++i) { retval.push_back(start+i*delta); }
+  return retval;
+} // function regularAxis
+
+/*!
+ * collect the axes of a constructed parameter space from the coordinates of
+ * its nodes
+ */
+template <typename Tcoord, typename Tresult>
+std::vector<std::vector<Tcoord>> gridAxes(opt::Grid<Tcoord, Tresult>& grid)
+{
+  std::vector<std::set<Tcoord>> values;
+  opt::Iterator<Tcoord, Tresult> it(
+      grid.createIterator(opt::ForwardNodeIter));
+  for (it.first(); !it.isDone(); ++it)
+  {
+    std::vector<Tcoord> const& c = (*it)->getCoordinates();
+    values.resize(c.size());
+    for (size_t i=0; i<c.size(); ++i) { values[i].insert(c[i]); }
+  }
+  std::vector<std::vector<Tcoord>> retval;
+  for (auto cit(values.cbegin()); cit != values.cend(); ++cit)
+  {
+    retval.push_back(std::vector<Tcoord>(cit->begin(), cit->end()));
+  }
+  return retval;
+} // function gridAxes
+
+#endif // include guard
+
+/* ----- END OF gridindex.h  ----- */
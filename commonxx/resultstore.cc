@@ -0,0 +1,141 @@
+/*! \file resultstore.cc
+ * \brief Columnar store of the results of a parameter space.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Columnar store of the results of a parameter space.
+ *
+
+ * ----
+ * This file is part of calex optimization.
+ *
+ * calex optimization is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * calex optimization is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with calex optimization.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include "resultstore.h"
+
+/* -------------------------------------------------------------------------- */
+ResultStore::ResultStore(std::vector<std::string> const& names,
+    bool single_precision) :
+  Mnames(names), Msingle(single_precision), Mrows(0)
+{
+  if (Mnames.empty()) { throw std::string("Result store without columns."); }
+  if (Msingle) { Mfloat.resize(Mnames.size()); }
+  else { Mdouble.resize(Mnames.size()); }
+} // ResultStore::ResultStore
+
+/* -------------------------------------------------------------------------- */
+size_t ResultStore::bytes() const
+{
+  return Mrows*Mnames.size()*(Msingle ? sizeof(float) : sizeof(double));
+} // function ResultStore::bytes
+
+/* -------------------------------------------------------------------------- */
+size_t ResultStore::column(std::string const& name) const
+{
+  auto const it = std::find(Mnames.begin(), Mnames.end(), name);
+  if (it == Mnames.end())
+  {
+    throw std::string("Unknown result column '"+name+"'.");
+  }
+  return it-Mnames.begin();
+} // function ResultStore::column
+
+/* -------------------------------------------------------------------------- */
+void ResultStore::resize(size_t rows)
+{
+  for (size_t i=0; i<Mnames.size(); ++i)
+  {
+    if (Msingle)
+    {
+      Mfloat[i].resize(rows, std::numeric_limits<float>::quiet_NaN());
+    } else
+    {
+      Mdouble[i].resize(rows, std::numeric_limits<double>::quiet_NaN());
+    }
+  }
+  Mrows = rows;
+} // function ResultStore::resize
+
+/* -------------------------------------------------------------------------- */
+void ResultStore::set(size_t row, std::vector<double> const& values)
+{
+  if (row >= Mrows) { throw std::string("Illegal row of result store."); }
+  for (size_t i=0; i<Mnames.size(); ++i)
+  {
+    set(row, i, i < values.size() ? values[i] :
+        std::numeric_limits<double>::quiet_NaN());
+  }
+} // function ResultStore::set
+
+/* -------------------------------------------------------------------------- */
+void ResultStore::appendRow(size_t row, std::vector<double>& values) const
+{
+  if (row >= Mrows) { throw std::string("Illegal row of result store."); }
+  for (size_t i=0; i<Mnames.size(); ++i)
+  {
+    values.push_back(value(row, i));
+  }
+} // function ResultStore::appendRow
+
+/* -------------------------------------------------------------------------- */
+std::vector<size_t> ResultStore::best(size_t column, size_t k) const
+{
+  if (column >= Mnames.size())
+  {
+    throw std::string("Illegal column of result store.");
+  }
+  // heap of the k best rows found so far, worst on top
+  std::vector<std::pair<double, size_t>> heap;
+  for (size_t row=0; 0 < k && row<Mrows; ++row)
+  {
+    double const v = value(row, column);
+    if (! (v == v)) { continue; }
+    if (heap.size() < k)
+    {
+      heap.push_back(std::make_pair(v, row));
+      std::push_heap(heap.begin(), heap.end());
+    } else
+    if (v < heap.front().first)
+    {
+      std::pop_heap(heap.begin(), heap.end());
+      heap.back() = std::make_pair(v, row);
+      std::push_heap(heap.begin(), heap.end());
+    }
+  }
+  std::sort_heap(heap.begin(), heap.end());
+  std::vector<size_t> retval;
+  for (auto cit(heap.cbegin()); cit != heap.cend(); ++cit)
+  {
+    retval.push_back(cit->second);
+  }
+  return retval;
+} // function ResultStore::best
+
+/* ----- END OF resultstore.cc  ----- */
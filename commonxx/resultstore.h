@@ -0,0 +1,123 @@
+/*! \file resultstore.h
+ * \brief Columnar store of the results of a parameter space.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Columnar store of the results of a parameter space. Every result
+ * field is kept in a contiguous array indexed by the row of the node
+ * (structure of arrays). Optionally the values are stored in single
+ * precision. Scans over a field, e.g. for the best nodes, touch the memory
+ * of this field only. It holds the results of the implicit grid of optnonlin,
+ * whose nodes are not kept in memory.
+ *
+
+ * ----
+ * This file is part of calex optimization.
+ *
+ * calex optimization is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * calex optimization is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with calex optimization.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  StoreVisitor removed; the store is used by the implicit
+ *                   grid only.
+ *
+ * ============================================================================
+ */
+
+#include <string>
+#include <vector>
+
+#ifndef _OPTIMIZE_COMMON_RESULTSTORE_H_
+#define _OPTIMIZE_COMMON_RESULTSTORE_H_
+
+/*!
+ * results of the nodes of a parameter space stored column by column
+ *
+ * The store is resized to the number of nodes first and the rows are set
+ * by their index. Different rows may be set concurrently, resizing must
+ * not overlap with any other access. Missing values are NaN.
+ */
+class ResultStore
+{
+  public:
+    /*!
+     * constructor
+     *
+     * \param names column names
+     * \param single_precision flag if values are stored as \c float
+     */
+    ResultStore(std::vector<std::string> const& names,
+        bool single_precision=false);
+    //! column names
+    std::vector<std::string> const& names() const { return Mnames; }
+    //! number of columns
+    size_t columns() const { return Mnames.size(); }
+    //! number of rows
+    size_t rows() const { return Mrows; }
+    //! memory occupied by the values in bytes
+    size_t bytes() const;
+    //! index of the column \a name
+    size_t column(std::string const& name) const;
+    //! resize to \a rows rows; new rows are NaN
+    void resize(size_t rows);
+    /*!
+     * set row \a row
+     *
+     * Missing trailing values are set to NaN, surplus values are ignored.
+     */
+    void set(size_t row, std::vector<double> const& values);
+    //! set column \a column of row \a row
+    void set(size_t row, size_t column, double value)
+    {
+      if (Msingle) { Mfloat[column][row] = value; }
+      else { Mdouble[column][row] = value; }
+    }
+    //! value of column \a column in row \a row
+    double value(size_t row, size_t column) const
+    {
+      return Msingle ? Mfloat[column][row] : Mdouble[column][row];
+    }
+    //! append the values of row \a row to \a values
+    void appendRow(size_t row, std::vector<double>& values) const;
+    /*!
+     * rows of the \a k least values of a column (ascending)
+     *
+     * Rows holding NaN are skipped.
+     */
+    std::vector<size_t> best(size_t column, size_t k) const;
+
+  private:
+    //! column names
+    std::vector<std::string> const Mnames;
+    //! flag if values are stored as float
+    bool const Msingle;
+    //! number of rows
+    size_t Mrows;
+    //! columns in double precision
+    std::vector<std::vector<double>> Mdouble;
+    //! columns in single precision
+    std::vector<std::vector<float>> Mfloat;
+
+}; // class ResultStore
+
+#endif // include guard
+
+/* ----- END OF resultstore.h  ----- */
@@ -0,0 +1,293 @@
+/*! \file sink.h
+ * \brief Streaming output of the nodes of a parameter space.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Streaming output of the nodes of a parameter space. The threads
+ * computing the nodes push the finished records to a lock-free queue which
+ * is drained by a dedicated writer thread. Thus the results are written
+ * while the computation is running and a run aborted prematurely still
+ * leaves the nodes computed so far in the result file.
+ *
+
+ * ----
+ * This file is part of calex optimization.
+ *
+ * calex optimization is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * calex optimization is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with calex optimization.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <vector>
+#include <ostream>
+#include <atomic>
+#include <functional>
+#include <boost/thread.hpp>
+#include <optimizexx/application.h>
+#include <optimizexx/node.h>
+#include "gridindex.h"
+
+#ifndef _OPTIMIZE_COMMON_SINK_H_
+#define _OPTIMIZE_COMMON_SINK_H_
+
+namespace opt = optimize;
+
+/*!
+ * unbounded lock-free queue for multiple producers and a single consumer
+ *
+ * Producers append an item by a single atomic exchange of the head. The
+ * consumer owns the tail. The queue always contains a dummy item.
+ *
+ * \tparam T item type (default constructible)
+ */
+template <typename T>
+class MpscQueue
+{
+  public:
+    //! constructor
+    MpscQueue() : Mhead(new Item), Mtail(Mhead.load()) { }
+    //! destructor
+    ~MpscQueue()
+    {
+      T value;
+      while (pop(value)) { }
+      delete Mtail;
+    }
+    //! append an item (any thread)
+    void push(T const& value)
+    {
+      Item* item = new Item;
+      item->value = value;
+      Item* prev = Mhead.exchange(item, std::memory_order_acq_rel);
+      prev->next.store(item, std::memory_order_release);
+    }
+    //! remove the oldest item (consumer thread only)
+    bool pop(T& value)
+    {
+      Item* next = Mtail->next.load(std::memory_order_acquire);
+      if (! next) { return false; }
+      value = next->value;
+      delete Mtail;
+      Mtail = next;
+      return true;
+    }
+
+  private:
+    MpscQueue(MpscQueue const&);
+    MpscQueue& operator=(MpscQueue const&);
+
+    //! item of the queue
+    struct Item
+    {
+      Item() : next(0) { }
+      T value;
+      std::atomic<Item*> next;
+    }; // struct Item
+
+    //! most recently pushed item
+    std::atomic<Item*> Mhead;
+    //! dummy item preceding the oldest item
+    Item* Mtail;
+
+}; // class MpscQueue
+
+/*!
+ * record of a finished node
+ *
+ * \tparam Tcoord coordinate type of the parameter space
+ * \tparam Tresult result type of the parameter space
+ */
+template <typename Tcoord, typename Tresult>
+struct SinkRecord
+{
+  //! linear grid index of the node
+  size_t index;
+  //! coordinates of the node
+  std::vector<Tcoord> coordinates;
+  //! result data of the node
+  Tresult result;
+}; // struct SinkRecord
+
+/*!
+ * result sink writing the records of finished nodes in the order of their
+ * completion
+ *
+ * The writer thread is started by the constructor. It flushes the stream
+ * whenever the queue runs empty, so the records written survive an abort.
+ * close() waits until all records pushed are written.
+ *
+ * \tparam Tcoord coordinate type of the parameter space
+ * \tparam Tresult result type of the parameter space
+ */
+template <typename Tcoord, typename Tresult>
+class ResultSink
+{
+  public:
+    //! record type
+    typedef SinkRecord<Tcoord, Tresult> Trecord;
+    //! function writing a record to a stream
+    typedef std::function<void (std::ostream&, Trecord const&)> Tformat;
+    //! function flushing a stream
+    typedef std::function<void (std::ostream&)> Tflush;
+
+    /*!
+     * constructor
+     *
+     * \param os stream the records are written to
+     * \param index linear index of the grid nodes
+     * \param format function writing a record
+     * \param header function writing a header line; called once with the
+     * first record
+     * \param flush function flushing the stream (default: flush only); it
+     * is called by the writer thread, e.g. to update a file header
+     */
+    ResultSink(std::ostream& os, GridIndex<Tcoord> const& index,
+        Tformat const& format, Tformat const& header=Tformat(),
+        Tflush const& flush=Tflush()) :
+      Mos(os), Mindex(index), Mformat(format), Mheader(header),
+      Mflush(flush), Mclosed(false),
+      Mwriter(boost::bind(&ResultSink<Tcoord, Tresult>::run, this))
+    { }
+    //! destructor
+    ~ResultSink() { close(); }
+    //! push the record of a finished node (any thread)
+    void push(std::vector<Tcoord> const& coordinates, Tresult const& result)
+    {
+      Trecord record;
+      record.index = Mindex(coordinates);
+      record.coordinates = coordinates;
+      record.result = result;
+      Mqueue.push(record);
+    }
+    //! write the remaining records and stop the writer thread
+    void close()
+    {
+      if (Mwriter.joinable())
+      {
+        Mclosed.store(true, std::memory_order_release);
+        Mwriter.join();
+      }
+    }
+
+  private:
+    //! writer thread function
+    void run()
+    {
+      Trecord record;
+      bool first = true;
+      bool written = false;
+      for (;;)
+      {
+        if (Mqueue.pop(record))
+        {
+          if (first && Mheader) { Mheader(Mos, record); }
+          first = false;
+          Mformat(Mos, record);
+          written = true;
+          continue;
+        }
+        if (written) { flush(); written = false; }
+        if (Mclosed.load(std::memory_order_acquire))
+        {
+          // all producers finished before close() was called
+          if (! Mqueue.pop(record)) { break; }
+          if (first && Mheader) { Mheader(Mos, record); }
+          first = false;
+          Mformat(Mos, record);
+          written = true;
+          continue;
+        }
+        boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+      }
+      flush();
+    }
+    //! flush the stream
+    void flush()
+    {
+      if (Mflush) { Mflush(Mos); }
+      else { Mos.flush(); }
+    }
+
+    //! output stream
+    std::ostream& Mos;
+    //! linear grid index
+    GridIndex<Tcoord> const& Mindex;
+    //! record format
+    Tformat const Mformat;
+    //! header format
+    Tformat const Mheader;
+    //! flush function
+    Tflush const Mflush;
+    //! queue of finished records
+    MpscQueue<Trecord> Mqueue;
+    //! flag if no more records will be pushed
+    std::atomic<bool> Mclosed;
+    //! writer thread (initialized last)
+    boost::thread Mwriter;
+
+}; // class ResultSink
+
+/*!
+ * parameter space visitor pushing the nodes computed by another visitor to
+ * a result sink
+ *
+ * \tparam Tcoord coordinate type of the parameter space
+ * \tparam Tresult result type of the parameter space
+ */
+template <typename Tcoord, typename Tresult>
+class SinkVisitor : public opt::ParameterSpaceVisitor<Tcoord, Tresult>
+{
+  public:
+    /*!
+     * constructor
+     *
+     * \param visitor visitor computing the results
+     * \param sink sink the nodes are pushed to
+     */
+    SinkVisitor(opt::ParameterSpaceVisitor<Tcoord, Tresult>& visitor,
+        ResultSink<Tcoord, Tresult>& sink) : Mvisitor(visitor), Msink(sink)
+    { }
+    //! visit function for a grid
+    virtual void operator()(opt::Grid<Tcoord, Tresult>* grid)
+    {
+      Mvisitor(grid);
+    }
+    //! visit function for a node
+    virtual void operator()(opt::Node<Tcoord, Tresult>* node)
+    {
+      Mvisitor(node);
+      Msink.push(node->getCoordinates(), node->getResultData());
+    }
+
+  private:
+    //! visitor computing the results
+    opt::ParameterSpaceVisitor<Tcoord, Tresult>& Mvisitor;
+    //! result sink
+    ResultSink<Tcoord, Tresult>& Msink;
+
+}; // class SinkVisitor
+
+#endif // include guard
+
+/* ----- END OF sink.h  ----- */
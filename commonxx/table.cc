@@ -0,0 +1,185 @@
+/*! \file table.cc
+ * \brief Binary result tables (implementation).
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Binary result tables (implementation).
+ *
+
+ * ----
+ * This file is part of calex optimization.
+ *
+ * calex optimization is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * calex optimization is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with calex optimization.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <sstream>
+#include <iomanip>
+#include <set>
+#include <cstdint>
+#include "table.h"
+
+namespace
+{
+  //! NumPy type descriptor of a double precision value of the host
+  std::string doubleDescr()
+  {
+    uint16_t const probe = 1;
+    return (1 == *reinterpret_cast<unsigned char const*>(&probe)) ?
+      "<f8" : ">f8";
+  }
+
+  //! quote a column name as Python string literal
+  std::string quote(std::string const& str)
+  {
+    std::string retval("'");
+    for (std::string::const_iterator cit(str.begin()); cit != str.end();
+        ++cit)
+    {
+      if ('\\' == *cit || '\'' == *cit) { retval += '\\'; }
+      retval += *cit;
+    }
+    return retval+"'";
+  }
+
+  //! make column names unique since NumPy rejects duplicate field names
+  std::vector<std::string> unique(std::vector<std::string> const& names)
+  {
+    std::vector<std::string> retval;
+    std::set<std::string> used;
+    for (auto cit(names.cbegin()); cit != names.cend(); ++cit)
+    {
+      std::string name(*cit);
+      for (int i=1; used.count(name); ++i)
+      {
+        std::ostringstream oss;
+        oss << *cit << "_" << i;
+        name = oss.str();
+      }
+      used.insert(name);
+      retval.push_back(name);
+    }
+    return retval;
+  }
+} // namespace (unnamed)
+
+/* -------------------------------------------------------------------------- */
+BinaryTable::BinaryTable(std::ostream& os, Format format,
+    std::vector<std::string> const& names) : Mos(os), Mformat(format),
+  Mnames(unique(names)), Mrows(0), Mheader(os.tellp())
+{
+  if (Mnames.empty()) { throw std::string("Table without columns."); }
+  if (npy == Mformat) { writeHeader(); }
+} // BinaryTable::BinaryTable
+
+/* -------------------------------------------------------------------------- */
+void BinaryTable::write(std::vector<double> const& row)
+{
+  if (row.size() != Mnames.size())
+  {
+    throw std::string("Number of values does not match table columns.");
+  }
+  Mos.write(reinterpret_cast<char const*>(&row[0]),
+      row.size()*sizeof(double));
+  ++Mrows;
+} // function BinaryTable::write
+
+/* -------------------------------------------------------------------------- */
+void BinaryTable::flush()
+{
+  if (npy == Mformat)
+  {
+    std::streampos const end(Mos.tellp());
+    Mos.seekp(Mheader);
+    writeHeader();
+    Mos.seekp(end);
+  }
+  Mos.flush();
+} // function BinaryTable::flush
+
+/* -------------------------------------------------------------------------- */
+void BinaryTable::finish()
+{
+  flush();
+  if (! Mos) { throw std::string("Writing binary table failed."); }
+} // function BinaryTable::finish
+
+/* -------------------------------------------------------------------------- */
+void BinaryTable::describe(std::ostream& os) const
+{
+  for (auto cit(Mnames.cbegin()); cit != Mnames.cend(); ++cit)
+  {
+    os << *cit << " " << doubleDescr() << std::endl;
+  }
+} // function BinaryTable::describe
+
+/* -------------------------------------------------------------------------- */
+void BinaryTable::writeHeader()
+{
+  // the shape has a fixed width, so the header does not change its size when
+  // the number of rows is patched
+  std::ostringstream dict;
+  dict << "{'descr': [";
+  for (auto cit(Mnames.cbegin()); cit != Mnames.cend(); ++cit)
+  {
+    dict << "(" << quote(*cit) << ", '" << doubleDescr() << "'), ";
+  }
+  dict << "], 'fortran_order': False, 'shape': (" << std::setw(20) << Mrows
+    << ",), }";
+  std::string header(dict.str());
+  // magic string, version, header length and header are aligned to 64 bytes
+  size_t const prefix = 10;
+  size_t const total = ((prefix+header.size()+1+63)/64)*64;
+  header.append(total-prefix-header.size()-1, ' ');
+  header += '\n';
+  if (header.size() > 65535) { throw std::string("Too many table columns."); }
+
+  Mos.write("\x93NUMPY\x01\x00", 8);
+  unsigned char const len[2] = {
+    static_cast<unsigned char>(header.size() & 0xff),
+    static_cast<unsigned char>(header.size() >> 8) };
+  Mos.write(reinterpret_cast<char const*>(len), 2);
+  Mos.write(header.data(), header.size());
+} // function BinaryTable::writeHeader
+
+/* -------------------------------------------------------------------------- */
+BinaryTable::Format binaryFormat(std::string const& name)
+{
+  if ("npy" == name) { return BinaryTable::npy; }
+  if ("bin" == name) { return BinaryTable::bin; }
+  throw std::string("Illegal binary format '"+name+"'.");
+} // function binaryFormat
+
+/* -------------------------------------------------------------------------- */
+std::vector<std::string> splitColumns(std::string const& line)
+{
+  std::vector<std::string> retval;
+  std::istringstream iss(line);
+  std::string name;
+  while (iss >> name) { retval.push_back(name); }
+  return retval;
+} // function splitColumns
+
+/* ----- END OF table.cc  ----- */
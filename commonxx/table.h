@@ -0,0 +1,125 @@
+/*! \file table.h
+ * \brief Binary result tables.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Binary result tables. The rows of a result table are written as
+ * records of double precision values in the byte order of the host. This is
+ * the layout of a NumPy structured array with one field per column and of
+ * the binary table input of GMT (option -bi). Thus no text has to be
+ * formatted and parsed again and the values keep their full precision.
+ *
+
+ * ----
+ * This file is part of calex optimization.
+ *
+ * calex optimization is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * calex optimization is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with calex optimization.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <string>
+#include <vector>
+#include <ostream>
+
+#ifndef _OPTIMIZE_COMMON_TABLE_H_
+#define _OPTIMIZE_COMMON_TABLE_H_
+
+/*!
+ * writer of a binary result table
+ *
+ * Formats:
+ *  - \c npy: NumPy .npy file (version 1.0) holding a one-dimensional
+ *    structured array with a \c float64 field for each column. The file may
+ *    be memory mapped with \c numpy.load(filename, mmap_mode='r').
+ *  - \c bin: raw records without any header (GMT: -bi<N>d). The column
+ *    names are available by describe().
+ *
+ * The number of rows of an \c npy file is patched into the header by
+ * flush() and finish(). Thus the stream must be seekable. A table flushed
+ * regularly is readable up to the last flush even if the program is
+ * aborted.
+ */
+class BinaryTable
+{
+  public:
+    //! binary formats
+    enum Format { npy, bin };
+
+    /*!
+     * constructor
+     *
+     * \param os binary output stream
+     * \param format table format
+     * \param names column names
+     */
+    BinaryTable(std::ostream& os, Format format,
+        std::vector<std::string> const& names);
+    //! number of columns
+    size_t columns() const { return Mnames.size(); }
+    //! number of rows written so far
+    size_t rows() const { return Mrows; }
+    //! write a row; the number of values must equal the number of columns
+    void write(std::vector<double> const& row);
+    //! update the number of rows of the header and flush the stream
+    void flush();
+    //! complete the table after the last row
+    void finish();
+    //! write a description of the column layout (one column per line)
+    void describe(std::ostream& os) const;
+
+  private:
+    //! write the header (with the current number of rows)
+    void writeHeader();
+
+    //! output stream
+    std::ostream& Mos;
+    //! table format
+    Format const Mformat;
+    //! column names
+    std::vector<std::string> const Mnames;
+    //! number of rows written
+    size_t Mrows;
+    //! stream position of the header
+    std::streampos Mheader;
+
+}; // class BinaryTable
+
+/*!
+ * parse the name of a binary format
+ *
+ * \param name format name (\c npy or \c bin)
+ */
+BinaryTable::Format binaryFormat(std::string const& name);
+
+/*!
+ * split a line of a text table into its columns
+ *
+ * The columns are separated by whitespace.
+ */
+std::vector<std::string> splitColumns(std::string const& line);
+
+#endif // include guard
+
+/* ----- END OF table.h  ----- */
@@ -0,0 +1,204 @@
+/*! \file topk.h
+ * \brief Collection of the K best nodes of a parameter space.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Collection of the K best nodes of a parameter space. The nodes
+ * are offered while the visitors pass them, so writing the best nodes does
+ * not require to iterate and sort the whole parameter space afterwards. The
+ * additional memory taken by the collection is O(K). The nodes offered are
+ * owned by the parameter space, which still keeps all of them unless its
+ * nodes are created on demand.
+ *
+
+ * ----
+ * This file is part of calex optimization.
+ *
+ * calex optimization is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * calex optimization is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with calex optimization.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  Corrected the statement on the memory used.
+ *
+ * ============================================================================
+ */
+
+#include <vector>
+#include <string>
+#include <limits>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+#include <boost/thread/mutex.hpp>
+#include <optimizexx/application.h>
+#include <optimizexx/node.h>
+
+#ifndef _OPTIMIZE_COMMON_TOPK_H_
+#define _OPTIMIZE_COMMON_TOPK_H_
+
+namespace opt = optimize;
+
+/*!
+ * bounded list of the K best nodes shared by all threads
+ *
+ * The rank of the K-th best node is kept in an atomic variable. Results not
+ * improving it are rejected without locking, thus after the first nodes
+ * only few results acquire the lock.
+ *
+ * \tparam Tcoord coordinate type of the parameter space
+ * \tparam Tresult result type of the parameter space
+ */
+template <typename Tcoord, typename Tresult>
+class TopKResults
+{
+  public:
+    //! node type of the parameter space
+    typedef opt::Node<Tcoord, Tresult> Tnode;
+    //! function ranking a result (smaller is better)
+    typedef std::function<double (Tresult const&)> Trank;
+
+    /*!
+     * constructor
+     *
+     * \param k number of nodes to keep
+     * \param rank function ranking the results; results ranked NaN or
+     * infinity are never kept
+     */
+    TopKResults(size_t k, Trank const& rank) : Mk(k), Mrank(rank),
+      Mbound(std::numeric_limits<double>::infinity())
+    {
+      if (0 == Mk) { throw std::string("Illegal number of best nodes."); }
+    }
+    /*!
+     * offer a computed node
+     *
+     * The node is ranked by its current result data. It must stay alive as
+     * long as the list is used.
+     */
+    void offer(Tnode* node)
+    {
+      double const rank = Mrank(node->getResultData());
+      if (! (rank < Mbound.load(std::memory_order_relaxed))) { return; }
+      boost::mutex::scoped_lock lock(Mmutex);
+      if (Mbest.size() == Mk)
+      {
+        if (! (rank < Mbest.front().rank)) { return; }
+        std::pop_heap(Mbest.begin(), Mbest.end(), compare);
+        Mbest.pop_back();
+      }
+      Entry entry;
+      entry.node = node;
+      entry.rank = rank;
+      Mbest.push_back(entry);
+      std::push_heap(Mbest.begin(), Mbest.end(), compare);
+      if (Mbest.size() == Mk)
+      {
+        Mbound.store(Mbest.front().rank, std::memory_order_relaxed);
+      }
+    }
+    //! the nodes kept sorted by their rank (best first)
+    std::vector<Tnode*> sorted() const
+    {
+      boost::mutex::scoped_lock lock(Mmutex);
+      std::vector<Entry> best(Mbest);
+      std::sort_heap(best.begin(), best.end(), compare);
+      std::vector<Tnode*> retval;
+      for (auto cit(best.cbegin()); cit != best.cend(); ++cit)
+      {
+        retval.push_back(cit->node);
+      }
+      return retval;
+    }
+
+  private:
+    //! node kept in the list
+    struct Entry
+    {
+      //! the node
+      Tnode* node;
+      //! rank of the result of the node when it was offered
+      double rank;
+    }; // struct Entry
+
+
+    //! heap order (worst node on top)
+    static bool compare(Entry const& e1, Entry const& e2)
+    {
+      return e1.rank < e2.rank;
+    }
+
+    //! number of nodes to keep
+    size_t const Mk;
+    //! ranking function
+    Trank const Mrank;
+    //! the best nodes as a heap
+    std::vector<Entry> Mbest;
+    //! lock of Mbest
+    mutable boost::mutex Mmutex;
+    //! rank of the K-th best node
+    std::atomic<double> Mbound;
+
+}; // class TopKResults
+
+/*!
+ * parameter space visitor offering the results of another visitor to a
+ * TopKResults list
+ *
+ * \tparam Tcoord coordinate type of the parameter space
+ * \tparam Tresult result type of the parameter space
+ */
+template <typename Tcoord, typename Tresult>
+class TopKVisitor : public opt::ParameterSpaceVisitor<Tcoord, Tresult>
+{
+  public:
+    /*!
+     * constructor
+     *
+     * \param visitor visitor computing the results
+     * \param results list the results are offered to
+     */
+    TopKVisitor(opt::ParameterSpaceVisitor<Tcoord, Tresult>& visitor,
+        TopKResults<Tcoord, Tresult>& results) :
+      Mvisitor(visitor), Mresults(results)
+    { }
+    //! visit function for a grid
+    virtual void operator()(opt::Grid<Tcoord, Tresult>* grid)
+    {
+      Mvisitor(grid);
+    }
+    //! visit function for a node
+    virtual void operator()(opt::Node<Tcoord, Tresult>* node)
+    {
+      Mvisitor(node);
+      Mresults.offer(node);
+    }
+
+  private:
+    //! visitor computing the results
+    opt::ParameterSpaceVisitor<Tcoord, Tresult>& Mvisitor;
+    //! list of the best nodes
+    TopKResults<Tcoord, Tresult>& Mresults;
+
+}; // class TopKVisitor
+
+#endif // include guard
+
+/* ----- END OF topk.h  ----- */
@@ -41,14 +41,30 @@
  *                    application. If not set maxit to 0.
  * 21/03/2013  V0.5.2 add comments to help text
  * 24/03/2013  V0.6   make use of boost::program_options custom validators
+ * 16/10/2026  V0.7   Write only the K best nodes.
+ * 16/10/2026  V0.8   Stream the results while the nodes are computed.
+ * 16/10/2026  V0.9   Binary result tables.
+ * 16/10/2026  V0.10  Binary result tables are written from a columnar result
+ *                    store.
+ * 16/10/2026  V0.10.1 The result store holds the RMS only; coordinates and
+ *                    calex values are written from the nodes.
+ *                    The row count of streamed npy tables is updated
+ *                    whenever the writer flushes.
+ * 16/10/2026  V0.10.2 Binary tables are written from the nodes like text
+ *                    output; the result store duplicating their RMS and
+ *                    '--result-precision' are removed.
  * 
  * ============================================================================
  */
  
-#define _OPTCALEX_VERSION_ "V0.6"
+#define _OPTCALEX_VERSION_ "V0.10.2"
 #define _OPTCALEX_LICENSE_ "GPLv2+"
 
 #include <vector>
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <cstdlib>
 #include <iomanip>
 #include <fstream>
 #include <memory>
@@ -62,6 +78,10 @@
 #include <calexxx/calexvisitor.h>
 #include <calexxx/defaults.h>
 #include "optcalexxx/validator.h"
+#include "commonxx/topk.h"
+#include "commonxx/sink.h"
+#include "commonxx/gridindex.h"
+#include "commonxx/table.h"
 
 namespace po = boost::program_options;
 namespace fs = boost::filesystem;
@@ -89,6 +109,7 @@ int main(int iargc, char* argv[])
     "                  [--alias arg] [--qac arg] [--finac arg]" "\n"
     "                  [--ns1 arg] [ns2 arg] [--m0 arg] [-p|--param arg]" "\n"
     "                  [--first-order arg] [--second-order arg]" "\n"
+    "                  [--top-k arg] [--stream] [--oformat arg]" "\n"
     "                  --calib-in arg --calib-out arg OUTFILE" "\n"
     "     or: optcalex -V|--version" "\n"
     "     or: optcalex -h|--help" "\n"
@@ -188,6 +209,21 @@ int main(int iargc, char* argv[])
     "calex then adjusted the amplitude (amp) and the delay (del) and" "\n"
     "computed a normalized root mean square (RMS) after the number of" "\n"
     "iterations specified by the 'iter' column." "\n"
+    "With '--top-k K' only the K best nodes sorted by their RMS are" "\n"
+    "written to OUTFILE." "\n"
+    "With '--stream' each node is written to OUTFILE as soon as calex" "\n"
+    "finished. The lines are in the order of completion and start with an" "\n"
+    "additional 'index' column holding the linear index of the node within" "\n"
+    "the grid (the last coordinate varies fastest). Sort the file by this" "\n"
+    "column to restore the order of the grid. A run aborted prematurely" "\n"
+    "leaves the nodes computed so far in OUTFILE." "\n"
+    "With '--oformat npy' or '--oformat bin' OUTFILE is a binary table of" "\n"
+    "double precision values in the byte order of the host with the" "\n"
+    "columns of the text format. 'npy' files carry the column names in" "\n"
+    "their header and are loaded with numpy.load(OUTFILE, mmap_mode='r')." "\n"
+    "'bin' files are raw records (GMT: -bi<N>d); the columns are listed in" "\n"
+    "OUTFILE.columns. Result values which are not numbers are stored as" "\n"
+    "NaN." "\n"
 
   };
 
@@ -199,6 +235,7 @@ int main(int iargc, char* argv[])
     defaultConfigFilePath /= ".optimize";
     defaultConfigFilePath /= "optcalex.rc";
     size_t numThreads = boost::thread::hardware_concurrency();
+    size_t topK = 0;
 
     // declare only commandline options
     po::options_description generic("Commandline options");
@@ -241,6 +278,13 @@ int main(int iargc, char* argv[])
        "Add first order subsystem to calex parameter file.")
       ("second-order", po::value<std::vector<calex::SecondOrderSubsystem> >(),
        "Add second order subsystem to calex parameter file.")
+      ("top-k", po::value<size_t>(&topK)->default_value(topK),
+       "Write only the K best nodes sorted by their RMS (0: write all "
+       "nodes).")
+      ("oformat", po::value<std::string>()->default_value("text"),
+       "Format of OUTFILE ('text', 'npy' or 'bin').")
+      ("stream", "Write the nodes in the order of their completion while they "
+       "are computed.")
       ("calib-in", po::value<fs::path>()->required(),
        "Filename of calibration input signal file (format: seife).")
       ("calib-out", po::value<fs::path>()->required(), 
@@ -438,6 +482,12 @@ int main(int iargc, char* argv[])
     {
       throw std::string("No grid system parameters specified.");
     }
+    if (topK && vm.count("stream"))
+    {
+      throw std::string("Streaming is not available with 'top-k'.");
+    }
+    std::string const oformat(vm["oformat"].as<std::string>());
+    if ("text" != oformat) { binaryFormat(oformat); }
 
     if (0 == calex_config.get_numActiveParameters() &&
        0 != calex_config.get_maxit())
@@ -480,7 +530,121 @@ int main(int iargc, char* argv[])
       cout << "optcalex: Sending calex application through parameter space "
         << "grid ..." << endl;
     }
-    algo->execute(app);
+    std::ofstream ofs(outpath.string().c_str(), "text" == oformat ?
+        std::ios::out : std::ios::out | std::ios::binary);
+    std::vector<std::string> param_names(
+        calex_config.get_gridSystemParameterNames<TcoordType>(*algo));
+
+    // binary result table; the columns of the calex results are known as
+    // soon as the first result is available
+    std::unique_ptr<BinaryTable> table;
+    auto columnNames = [&param_names](TresultType const& result, bool index)
+    {
+      std::vector<std::string> names;
+      if (index) { names.push_back("index"); }
+      names.insert(names.end(), param_names.begin(), param_names.end());
+      std::ostringstream oss;
+      result.writeHeaderInfo(oss);
+      std::vector<std::string> const info(splitColumns(oss.str()));
+      names.insert(names.end(), info.begin(), info.end());
+      return names;
+    };
+    auto createTable = [&](TresultType const& result, bool index)
+    {
+      table.reset(new BinaryTable(ofs, binaryFormat(oformat),
+            columnNames(result, index)));
+    };
+    // values of a result; columns which are not numbers are NaN
+    auto appendValues = [](TresultType const& result,
+        std::vector<double>& row)
+    {
+      std::ostringstream oss;
+      result.writeLine(oss);
+      std::vector<std::string> const values(splitColumns(oss.str()));
+      for (auto cit(values.cbegin()); cit != values.cend(); ++cit)
+      {
+        char* end = 0;
+        double const value = strtod(cit->c_str(), &end);
+        row.push_back(*end ? std::numeric_limits<double>::quiet_NaN() :
+            value);
+      }
+    };
+    auto writeRow = [&table, &appendValues](std::vector<double> row,
+        TresultType const& result)
+    {
+      appendValues(result, row);
+      row.resize(table->columns(), std::numeric_limits<double>::quiet_NaN());
+      table->write(row);
+    };
+
+    // collect the best nodes while the calex application passes the nodes
+    std::unique_ptr<TopKResults<TcoordType, TresultType>> best;
+    if (topK)
+    {
+      best.reset(new TopKResults<TcoordType, TresultType>(topK,
+            [](TresultType const& result) -> double
+            {
+              return result.get_rms();
+            }));
+      TopKVisitor<TcoordType, TresultType> topk_app(app, *best);
+      algo->execute(topk_app);
+    } else
+    if (vm.count("stream"))
+    {
+      // write the nodes by a dedicated thread while calex computes them
+      typedef ResultSink<TcoordType, TresultType> Tsink;
+      GridIndex<TcoordType> const index(
+          gridAxes(algo->getParameterSpace()));
+      Tsink sink(ofs, index,
+          [&table, &writeRow](std::ostream& os,
+            Tsink::Trecord const& record)
+          {
+            if (table)
+            {
+              std::vector<double> row(1, record.index);
+              row.insert(row.end(), record.coordinates.begin(),
+                  record.coordinates.end());
+              writeRow(row, record.result);
+              return;
+            }
+            os << std::setw(10) << std::left << record.index << " ";
+            for (auto cit(record.coordinates.cbegin());
+                cit != record.coordinates.cend(); ++cit)
+            {
+              os << std::setw(12) << std::fixed << std::left << *cit << " ";
+            }
+            os << "    ";
+            record.result.writeLine(os);
+          },
+          [&](std::ostream& os, Tsink::Trecord const& record)
+          {
+            if ("text" != oformat)
+            {
+              createTable(record.result, true);
+              return;
+            }
+            os << std::setw(10) << std::left << "index" << " ";
+            for (auto cit(param_names.cbegin()); cit != param_names.cend();
+                ++cit)
+            {
+              os << std::setw(12) << std::fixed << std::left << *cit << " ";
+            }
+            os << "    ";
+            record.result.writeHeaderInfo(os);
+          },
+          // the row count of npy tables is updated on each flush
+          [&table](std::ostream& os)
+          {
+            if (table) { table->flush(); }
+            else { os.flush(); }
+          });
+      SinkVisitor<TcoordType, TresultType> sink_app(app, sink);
+      algo->execute(sink_app);
+      sink.close();
+    } else
+    {
+      algo->execute(app);
+    }
 
     // collect results and write to outpath
     if (vm.count("verbose"))
@@ -491,36 +655,71 @@ int main(int iargc, char* argv[])
         << endl;
     }
 
-    std::ofstream ofs(outpath.string().c_str());
-    // write header information
-    // write header information for parameter space parameters
-    std::vector<std::string> param_names(
-        calex_config.get_gridSystemParameterNames<TcoordType>(*algo));
-    for (auto cit(param_names.cbegin()); cit != param_names.cend(); ++cit)
+    // the nodes were written already if streamed
+    if (! vm.count("stream"))
     {
-      ofs << std::setw(12) << std::fixed << std::left << *cit << " ";
+      opt::Iterator<TcoordType, TresultType> it(
+        algo->getParameterSpace().createIterator(opt::ForwardNodeIter));
+      it.first();
+      if ("text" != oformat)
+      {
+        createTable((*it)->getResultData(), false);
+      } else
+      {
+        // write header information
+        // write header information for parameter space parameters
+        for (auto cit(param_names.cbegin()); cit != param_names.cend(); ++cit)
+        {
+          ofs << std::setw(12) << std::fixed << std::left << *cit << " ";
+        }
+        ofs << "    ";
+        // write header information of result data
+        (*it)->getResultData().writeHeaderInfo(ofs);
+      }
+
+      // write data
+      auto write = [&ofs, &table, &writeRow](
+          opt::Node<TcoordType, TresultType> const* node)
+      {
+        // write search parameter
+        std::vector<TcoordType> const& c = node->getCoordinates();
+        if (table)
+        {
+          writeRow(std::vector<double>(c.begin(), c.end()),
+              node->getResultData());
+          return;
+        }
+        for (auto cit(c.cbegin()); cit != c.cend(); ++cit)
+        {
+          ofs << std::setw(12) << std::fixed << std::left << *cit << " ";
+        }
+        ofs << "    ";
+        // write result data
+        node->getResultData().writeLine(ofs);
+      };
+      if (best)
+      {
+        std::vector<opt::Node<TcoordType, TresultType>*> const nodes(
+            best->sorted());
+        std::for_each(nodes.begin(), nodes.end(), write);
+      } else
+      {
+        while (!it.isDone())
+        {
+          write(*it);
+          ++it;
+        }
+      }
     }
-    ofs << "    ";
-    // write header information of result data
-    opt::Iterator<TcoordType, TresultType> it(
-      algo->getParameterSpace().createIterator(opt::ForwardNodeIter));
-    it.first();
-    (*it)->getResultData().writeHeaderInfo(ofs);
-
-    // write data
-    while (!it.isDone())
+
+    if (table)
     {
-      // write search parameter
-      std::vector<TcoordType> const& c = (*it)->getCoordinates();
-      for (auto cit(c.cbegin()); cit != c.cend(); ++cit)
+      table->finish();
+      if (BinaryTable::bin == binaryFormat(oformat))
       {
-        ofs << std::setw(12) << std::fixed << std::left << *cit << " ";
+        std::ofstream cfs((outpath.string()+".columns").c_str());
+        table->describe(cfs);
       }
-      ofs << "    ";
-      // write result data
-      (*it)->getResultData().writeLine(ofs);
-
-      ++it;
     }
 
     if (vm.count("verbose"))
@@ -38,17 +38,60 @@
  * REVISIONS and CHANGES 
  * 19/04/2012   V0.1      Daniel Armbruster
  * 02/05/2012   V0.1.1    Corrections of help text and seismometer models.
+ * 16/10/2026   V0.2      Evaluation of the RMS misfit from the Gram matrix of
+ *                        the regressors.
+ * 16/10/2026   V0.3      Runtime selection of vectorized misfit kernels.
+ * 16/10/2026   V0.4      Batched evaluation of parameter space nodes.
+ * 16/10/2026   V0.5      Single precision misfit computation.
+ * 16/10/2026   V0.6      Selectable seismometer models. Node coordinates are
+ *                        looked up by parameter id.
+ * 16/10/2026   V0.7      Variable projection of the coefficients of the
+ *                        nonlinear terms.
+ * 16/10/2026   V0.8      Adaptive coarse-to-fine grid refinement.
+ * 16/10/2026   V0.9      Levenberg-Marquardt polish of the best nodes.
+ * 16/10/2026   V0.10     Early abort of nodes which cannot be among the best.
+ * 16/10/2026   V0.11     Write only the K best nodes.
+ * 16/10/2026   V0.12     Stream the results while the nodes are computed.
+ * 16/10/2026   V0.13     Binary result tables.
+ * 16/10/2026   V0.14     Memory mapped raw input files.
+ * 16/10/2026   V0.15     Parallel reader of single column ASCII files. Both
+ *                        input files are read concurrently.
+ * 16/10/2026   V0.16     On-disk cache of prepared regressors.
+ * 16/10/2026   V0.17     Screening of the nodes on decimated data.
+ * 16/10/2026   V0.18     Band limited misfit in the frequency domain.
+ * 16/10/2026   V0.19     Logarithmic and list axes of unknown parameters.
+ * 16/10/2026   V0.20     Branch and bound search of the grid minimum.
+ * 16/10/2026   V0.21     Fused preparation of derivatives and regressors.
+ * 16/10/2026   V0.22     Selectable derivative operators.
+ * 16/10/2026   V0.23     Regressors are stored in an aligned FeatureMatrix.
+ * 16/10/2026   V0.24     Implicit index addressed parameter space grid.
+ * 16/10/2026   V0.25     Columnar result store of the implicit grid.
+ * 16/10/2026   V0.25.1   Parallel reader of seife files replaces the single
+ *                        column ASCII format.
+ *                        Failures of the cache are reported as warnings.
+ *                        The implicit grid stores the RMS misfit only.
+ *                        A stalled polish is not reported as converged.
+ *                        The nodes of a refinement level are evaluated in a
+ *                        single pass. '--md-best' is rejected in 'direct'
+ *                        evaluation mode.
+ *                        Help on the misfit of screened-out nodes.
+ *                        The implicit grid stores the profiled parameters.
+ *                        The row count of streamed npy tables is updated
+ *                        whenever the writer flushes.
+ *                        Cached regressors are used in place.
  * 
  * ============================================================================
  */
  
-#define _OPTNONLIN_VERSION_ "V0.1.1"
+#define _OPTNONLIN_VERSION_ "V0.25.1"
 #define _OPTNONLIN_LICENSE_ "GPLv2"
 
 #include <vector>
 #include <string>
 #include <fstream>
+#include <sstream>
 #include <algorithm>
+#include <limits>
 #include <boost/program_options.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/thread.hpp>
@@ -60,6 +103,25 @@
 #include "optnonlinxx/visitor.h"
 #include "optnonlinxx/validator.h"
 #include "optnonlinxx/util.h"
+#include "optnonlinxx/derivative.h"
+#include "optnonlinxx/featurematrix.h"
+#include "optnonlinxx/kernel.h"
+#include "optnonlinxx/gram.h"
+#include "optnonlinxx/cache.h"
+#include "optnonlinxx/screening.h"
+#include "optnonlinxx/spectrum.h"
+#include "optnonlinxx/bnb.h"
+#include "optnonlinxx/batch.h"
+#include "optnonlinxx/implicitgrid.h"
+#include "optnonlinxx/model.h"
+#include "optnonlinxx/coordinates.h"
+#include "optnonlinxx/refinement.h"
+#include "optnonlinxx/polish.h"
+#include "optnonlinxx/prune.h"
+#include "optnonlinxx/mapped.h"
+#include "optnonlinxx/seifereader.h"
+#include "commonxx/gridindex.h"
+#include "commonxx/table.h"
 
 namespace po = boost::program_options;
 namespace fs = boost::filesystem;
@@ -80,7 +142,22 @@ int main(int iargc, char* argv[])
     "    SVN: $Id$\n" 
     " Author: Daniel Armbruster" "\n"
     "  Usage: optnonlin [-v|--verbose] [-o|--overwrite] [-t|--threads]" "\n"
-    "                   [--config-file arg] [--linear] [--iformat arg]" "\n"
+    "                   [--config-file arg] [--linear] [--model arg]" "\n"
+    "                   [--iformat arg] [--dt arg] [--preparation arg]" "\n"
+    "                   [--derivative arg]" "\n"
+    "                   [--evaluation arg] [--gain] [--md-best arg]" "\n"
+    "                   [--search arg] [--bnb-tolerance arg] [--grid arg]" "\n"
+    "                   [--domain arg] [--fmin arg] [--fmax arg]" "\n"
+    "                   [--kernel arg] [--result-precision arg]" "\n"
+    "                   [--batch arg] [--precision arg]" "\n"
+    "                   [--precision-check arg] [--refine arg]" "\n"
+    "                   [--refine-best arg] [--refine-threshold arg]" "\n"
+    "                   [--polish arg] [--polish-file arg]" "\n"
+    "                   [--prune-topk arg] [--top-k arg] [--stream]" "\n"
+    "                   [--oformat arg] [--huge-pages]" "\n"
+    "                   [--no-cache] [--cache-dir arg] [--cache-limit arg]" "\n"
+    "                   [--screen arg] [--screen-margin arg]" "\n"
+    "                   [--screen-keep arg] [--screen-check arg]" "\n"
     "                   -p|--param arg -p|--param arg -p|--param arg" "\n"
     "                   [-p|--param arg -p|--param arg]" "\n"
     "                   --calib-in arg --calib-out arg OUTFILE" "\n"
@@ -119,6 +196,15 @@ int main(int iargc, char* argv[])
     "arguments for the unknown parameters" "\n"
     "'-p|--param c0 start end delta' and" "\n"
     "'-p|--param c1 start end delta' will be ignored if passed." "\n"
+    "\n--------------------\n"
+    "Further system models:" "\n"
+    "'--model name' selects the nonlinear terms added to the linear model:" "\n"
+    "   linear              none (same as '--linear')" "\n"
+    "   cubic               c0*y^2+c1*y^3 (default)" "\n"
+    "   quadratic-damping   c0*y'*|y'|" "\n"
+    "   odd                 c0*|y|*y+c1*y^3" "\n"
+    "   product             c0*y*y'" "\n"
+    "The coefficient of the i-th term is the unknown parameter 'ci'." "\n"
     "\n-------------------------------------------------------\n"
     "Additional notes on optnonlin unknown parameter syntax:\n"
     "To perform a parameter search with optnonlin search ranges for the" "\n"
@@ -127,23 +213,299 @@ int main(int iargc, char* argv[])
     "-p|--param id start end delta" "\n"
     "where" "\n"
     "   id      id of the unknown parameter" "\n"
-    "           (either 'T0' or 'h' or 'c1' or 'c2')" "\n"
+    "           (either 'T0' or 'h' or 'c0' or 'c1')" "\n"
     "   start   start of the search range" "\n"
     "   end     end of the search range" "\n"
     "   delta   stepwidth in search range" "\n\n"
+    "Parameters spanning orders of magnitude are sampled at logarithmically" "\n"
+    "spaced values with" "\n"
+    "-p|--param id log start end n" "\n"
+    "where 'n' is the number of values from 'start' to 'end' (both" "\n"
+    "positive). Arbitrary values are passed as a list:" "\n"
+    "-p|--param id list value [value ...]" "\n"
+    "The values may be separated by blanks or semicolons. Grid refinement" "\n"
+    "('--refine') requires linear axes." "\n\n"
     "Note if two parameters with the same id were specified the first one" "\n"
-    "will be taken." "\n"
+    "will be taken. Parameters not used by the model are ignored." "\n"
+    "\n----------------------------------\n"
+    "Additional notes on input formats:\n"
+    "Besides of the formats of libdatrwxx '--iformat raw' is available." "\n"
+    "Files of the raw format consist of the samples only (IEEE double" "\n"
+    "precision values in the byte order of the host). They are mapped into" "\n"
+    "memory and are not copied. Since raw files carry no header the" "\n"
+    "sampling interval must be passed with '--dt'. The consistency check" "\n"
+    "of the headers then compares the number of samples only." "\n"
+    "Files of the ASCII format seife are read by several threads (see" "\n"
+    "'--threads'). The header is decoded first, then the sample section is" "\n"
+    "split into chunks at line breaks which are parsed in parallel. The" "\n"
+    "format field of the header is ignored, the samples are read in free" "\n"
+    "format." "\n"
+    "Both input files are read concurrently." "\n"
+    "\n-------------------------\n"
+    "Additional notes on evaluation modes:\n"
+    "By default ('--evaluation direct') optnonlin computes the misfit of" "\n"
+    "each parameter configuration from the time series. Since the model" "\n"
+    "residual is linear in the coefficients the RMS misfit alternatively" "\n"
+    "is computed from the inner products of the regressor time series" "\n"
+    "('--evaluation gram'). These are computed once, so the cost of a" "\n"
+    "parameter configuration does not depend on the length of the time" "\n"
+    "series anymore. The MD misfit cannot be computed this way and is" "\n"
+    "written as 'nan'. Use '--md-best N' to compute both misfits from the" "\n"
+    "time series for the N parameter configurations with the smallest RMS" "\n"
+    "misfit. '--md-best' is rejected in 'direct' evaluation mode, which" "\n"
+    "computes the MD misfit of all configurations anyway." "\n"
+    "The coefficients c0, c1, ... of the nonlinear terms enter the" "\n"
+    "residual linearly. With '--evaluation projection' only T0 and h are" "\n"
+    "gridded and the coefficients minimizing the RMS misfit are solved" "\n"
+    "for at each node from the Gram matrix (variable projection). With" "\n"
+    "'--gain' the gain of the calibration signal is solved for as well." "\n"
+    "The optimal values are written after the misfits in the order c0," "\n"
+    "c1, ..., gain. Parameters 'ci' passed are ignored in this mode. The" "\n"
+    "MD misfit is handled like in 'gram' evaluation mode." "\n"
+    "With '--domain freq' the inner products are computed from the" "\n"
+    "discrete Fourier transforms of the regressors which are restricted" "\n"
+    "to the passband from '--fmin' to '--fmax' (in Hz; 0: Nyquist" "\n"
+    "frequency). Thus the RMS misfit is the misfit of the bandpass" "\n"
+    "filtered residual relative to the bandpass filtered calibration" "\n"
+    "signal and noise outside of the passband is ignored. The series are" "\n"
+    "transformed once at startup; the cost of a node is the same as in" "\n"
+    "the time domain. The frequency domain requires 'gram' or" "\n"
+    "'projection' evaluation mode. '--md-best' and '--polish' use the" "\n"
+    "band limited inner products as well, while the MD misfit always is" "\n"
+    "computed from the full time series." "\n"
+    "\n---------------------------------\n"
+    "Additional notes on implicit grids:\n"
+    "By default every node of the parameter space grid is constructed" "\n"
+    "before the evaluation starts. With '--grid implicit' a node is" "\n"
+    "addressed by its linear index instead; its coordinates are decoded" "\n"
+    "when it is evaluated and only its RMS misfit is stored, i.e. 8 bytes" "\n"
+    "per node or 4 bytes with '--result-precision float'. With" "\n"
+    "'--evaluation projection' the profiled coefficients (and the gain)" "\n"
+    "are stored as well. Output and the selection of the best nodes read" "\n"
+    "the stored values; the starting points of '--polish' are recomputed." "\n"
+    "The MD misfit is 'nan' in the output except for the nodes recomputed" "\n"
+    "by '--md-best'." "\n"
+    "With '--top-k K' the K best nodes are recomputed to write their" "\n"
+    "complete results in full precision. The misfit of pruned nodes is" "\n"
+    "stored as 'nan'. Nodes are evaluated in blocks of" "\n"
+    "'--batch' nodes. The implicit grid is not available with '--refine'," "\n"
+    "'--stream', '--search bnb' or '--screen'." "\n"
+    "\n------------------------------\n"
+    "Additional notes on branch and bound search:\n"
+    "With '--search bnb' only the node with the smallest RMS misfit is" "\n"
+    "searched for instead of computing all nodes of the grid. Boxes of" "\n"
+    "nodes are split recursively. Since the residual is linear in the" "\n"
+    "coefficients of the model a lower bound of the RMS misfit of all" "\n"
+    "nodes of a box is computed from the Gram matrix. Boxes whose bound" "\n"
+    "exceeds the best misfit found so far are discarded. All threads share" "\n"
+    "a queue of boxes ordered by their bound. Boxes are split until they" "\n"
+    "hold a single node, so the result is the minimum of the grid, i.e." "\n"
+    "the minimizer to the resolution of the '-p' axes. With" "\n"
+    "'--bnb-tolerance tol' boxes are discarded if their bound exceeds the" "\n"
+    "best misfit times (1-tol); the misfit of the result then is within" "\n"
+    "this relative tolerance of the grid minimum. OUTFILE holds the best" "\n"
+    "node only (the MD misfit is written as 'nan'). The number of boxes" "\n"
+    "evaluated and the certified lower bound of the misfit are reported." "\n"
+    "The search is not available with '--evaluation projection'," "\n"
+    "'--refine', '--stream' or '--screen'." "\n"
+    "\n------------------------------\n"
+    "Additional notes on preparation:\n"
+    "The derivatives of the output signal and the regressors of the" "\n"
+    "nonlinear terms are computed within a single multithreaded pass over" "\n"
+    "the samples ('--preparation fused'). '--preparation reference'" "\n"
+    "computes each series by a separate pass instead. The derivatives of" "\n"
+    "both are identical; powers of y may differ in the last digit since" "\n"
+    "the fused pass multiplies instead of calling pow()." "\n"
+    "\n------------------------------\n"
+    "Additional notes on derivatives:\n"
+    "The derivatives of the output signal are computed by FIR filters" "\n"
+    "selected with '--derivative'. 'central3' (default) is the 3-point" "\n"
+    "central difference, 'central5' and 'central7' are the 5- and 7-point" "\n"
+    "central differences of higher order. 'sgW' resp. 'sgW:P' selects" "\n"
+    "Savitzky-Golay derivatives which fit a polynomial of order P" "\n"
+    "(default: 4) to W samples (W odd, at least 5); they suppress high" "\n"
+    "frequency noise at the cost of bandwidth. Samples closer than W/2 to" "\n"
+    "the ends take the derivatives of their nearest interior sample." "\n"
+    "\n------------------------------\n"
+    "Additional notes on misfit kernels:\n"
+    "The misfit is computed by vectorized kernels. By default ('--kernel" "\n"
+    "auto') the kernel is chosen according to the instruction set" "\n"
+    "extensions the CPU supports. Available kernels are 'scalar', 'sse2'," "\n"
+    "'avx2' and 'avx512'. The 'scalar' kernel is the reference" "\n"
+    "implementation. Since vectorized kernels sum up in a different order" "\n"
+    "their results differ in the order of the rounding error." "\n"
+    "\n----------------------------------\n"
+    "Additional notes on batched evaluation:\n"
+    "With '--batch N' (N > 0) the parameter space nodes are evaluated in" "\n"
+    "blocks of N consecutive nodes. The time series are processed in" "\n"
+    "cache sized tiles and each tile is used for all nodes of a block" "\n"
+    "before the next one is loaded. Since the sums are accumulated tile by" "\n"
+    "tile the misfits are equal to those of the per-node evaluation up to" "\n"
+    "rounding. Batches are ignored in 'gram' and 'projection' evaluation" "\n"
+    "mode which do not touch the time series per node." "\n"
+    "\n-----------------------------\n"
+    "Additional notes on precision:\n"
+    "With '--precision float' the time series are prepared in double" "\n"
+    "precision and then stored in single precision for the misfit" "\n"
+    "computation. This halves the memory bandwidth and doubles the" "\n"
+    "number of samples processed per vector instruction. The residual is" "\n"
+    "computed in single precision while the sums are accumulated in" "\n"
+    "double precision. Afterwards the misfit of N sampled nodes" "\n"
+    "('--precision-check N') is recomputed in double precision and the" "\n"
+    "maximum deviation is reported. The option does not affect the" "\n"
+    "'gram' and 'projection' evaluation modes." "\n"
+    "\n------------------------------\n"
+    "Additional notes on grid refinement:\n"
+    "With '--refine L' (L > 0) the search starts on a coarse grid with" "\n"
+    "the stepwidths multiplied by 2^L. On each level the cells around the" "\n"
+    "N best nodes ('--refine-best N') and around nodes with an RMS misfit" "\n"
+    "below a threshold ('--refine-threshold') are searched with half the" "\n"
+    "stepwidth until the requested stepwidths are reached. All evaluated" "\n"
+    "nodes are written to OUTFILE with the level they were evaluated at" "\n"
+    "first in the column following the coordinates. Nodes of the finest" "\n"
+    "level are identical to the nodes of the full grid. The new nodes of" "\n"
+    "all cells of a level are evaluated together in one pass; nodes shared" "\n"
+    "by adjacent cells or known from a coarser level are evaluated once." "\n"
+    "The options '--md-best' and '--precision-check' are ignored if" "\n"
+    "refining." "\n"
+    "\n--------------------------\n"
+    "Additional notes on polishing:\n"
+    "The precision of a grid search is limited by the stepwidths. With" "\n"
+    "'--polish K' the K nodes with the smallest RMS misfit are used as" "\n"
+    "starting points of a Levenberg-Marquardt minimization of the sum of" "\n"
+    "the squared residual with respect to h, T0, c0, c1, ... (and the" "\n"
+    "gain if '--gain' is passed). The Jacobian is computed analytically" "\n"
+    "from the Gram matrix of the regressors. The results are written to" "\n"
+    "the file passed with '--polish-file' (default: OUTFILE.polish) with" "\n"
+    "one line per starting node containing the optimal parameters, the" "\n"
+    "MD and RMS misfit, the number of iterations, a flag if the iteration" "\n"
+    "converged and a flag if it stalled, i.e. stopped without converging" "\n"
+    "since no damping of the step decreased the misfit any further." "\n"
+    "\n-------------------------\n"
+    "Additional notes on pruning:\n"
+    "The sum of the squared residual of a node only grows while the" "\n"
+    "samples are summed up. With '--prune-topk K' the computation of a" "\n"
+    "node is aborted as soon as its partial sum shows that it cannot be" "\n"
+    "among the K best nodes found so far. The partial sums are checked" "\n"
+    "after each block of samples. Pruned nodes are written with their" "\n"
+    "partial misfits (which are lower bounds) followed by 'pruned'. The" "\n"
+    "nodes are evaluated in batches (see '--batch') in interleaved order" "\n"
+    "so the whole parameter space is sampled coarsely first to find good" "\n"
+    "nodes early. Pruning requires 'direct' evaluation mode." "\n"
+    "\n-------------------------\n"
+    "Additional notes on the K best nodes:\n"
+    "With '--top-k K' only the K best nodes sorted by their RMS misfit are" "\n"
+    "written to OUTFILE instead of all nodes of the parameter space. The" "\n"
+    "best nodes are collected while the nodes are computed so the" "\n"
+    "parameter space is not iterated afterwards. The nodes passed to" "\n"
+    "'--md-best' and '--polish' are taken from the K best nodes then." "\n"
+    "Pruned nodes are never among the K best nodes." "\n"
+    "Only the collection of the best nodes takes memory proportional to" "\n"
+    "K. All nodes of the grid are kept in memory nonetheless unless" "\n"
+    "'--grid implicit' is given, which stores a few values per node." "\n"
+    "\n-------------------------\n"
+    "Additional notes on streaming:\n"
+    "With '--stream' each node is written to OUTFILE as soon as it is" "\n"
+    "computed. The lines are in the order of completion and start with" "\n"
+    "an additional column holding the linear index of the node within" "\n"
+    "the grid (the last coordinate varies fastest), so the file may be" "\n"
+    "sorted afterwards, e.g. with 'sort -n'. A run aborted prematurely" "\n"
+    "leaves the nodes computed so far in OUTFILE. Nodes whose MD misfit" "\n"
+    "is computed by '--md-best' are written a second time; the latter" "\n"
+    "line supersedes the former one. Streaming is not available together" "\n"
+    "with '--top-k' or '--refine'." "\n"
+    "\n-------------------------\n"
+    "Additional notes on binary result tables:\n"
+    "With '--oformat npy' or '--oformat bin' OUTFILE is a binary table of" "\n"
+    "double precision values in the byte order of the host. There is one" "\n"
+    "record per node holding the columns 'index' (with '--stream'), the" "\n"
+    "coordinates named by their parameter ids, 'level' (with '--refine')," "\n"
+    "'md', 'rms', the profiled parameters (with '--evaluation projection')" "\n"
+    "and 'pruned' (1 if the node was pruned). 'npy' files carry the column" "\n"
+    "names in their header and are loaded as structured arrays with" "\n"
+    "numpy.load(OUTFILE, mmap_mode='r'). 'bin' files are raw records (GMT:" "\n"
+    "-bi<N>d); the columns are listed in OUTFILE.columns." "\n"
+    "\n-------------------------\n"
+    "Additional notes on the cache:\n"
+    "The derivatives of the output signal, the regressors of the model and" "\n"
+    "the Gram matrix are stored in '--cache-dir'. Entries are identified by" "\n"
+    "a hash of the input samples, the sampling interval and the model." "\n"
+    "Repeated runs on the same data map the entry into memory and use the" "\n"
+    "mapped regressors in place instead of preparing them again; then" "\n"
+    "'--huge-pages' does not apply. If the cache exceeds '--cache-limit'" "\n"
+    "the least recently used entries are removed. '--no-cache' disables" "\n"
+    "the cache. The cache is used on a best-effort basis: if its directory" "\n"
+    "cannot be created or an entry cannot be read or written a warning is" "\n"
+    "printed and optnonlin continues without it." "\n"
+    "\n-------------------------\n"
+    "Additional notes on screening:\n"
+    "With '--screen D' the misfit of all nodes is computed on a copy of" "\n"
+    "the time series first which is lowpass filtered and decimated by the" "\n"
+    "factor D. Only nodes whose screened RMS misfit does not exceed the" "\n"
+    "best screened RMS misfit by more than '--screen-margin' (relative)" "\n"
+    "or which are among the best fraction '--screen-keep' of all nodes are" "\n"
+    "computed on the full time series. The other nodes are written with" "\n"
+    "their screened misfits followed by 'pruned'. These are the misfits of" "\n"
+    "the decimated data, not lower bounds of the full misfits, and are not" "\n"
+    "comparable with the misfits of the computed nodes (unlike the lower" "\n"
+    "bounds of '--prune-topk'). Afterwards the number of" "\n"
+    "eliminated nodes and the deviation of the screened from the full RMS" "\n"
+    "misfit of the computed nodes are reported. Additionally up to" "\n"
+    "'--screen-check' eliminated nodes of each grid are computed on the" "\n"
+    "full data; nodes which would have passed the screening indicate a" "\n"
+    "margin too small. Screening requires 'direct' evaluation mode." "\n"
   };
 
   try
   {
     fs::path configFilePath;
-    fs::path defaultConfigFilePath(std::string(getenv("HOME")));
+    // without HOME the configuration and the cache are looked up in the
+    // working directory
+    char const* home = getenv("HOME");
+    fs::path const homeDir(home ? home : ".");
+    fs::path defaultConfigFilePath(homeDir);
     defaultConfigFilePath /= ".optimize";
     defaultConfigFilePath /= "optnonlin.rc";
     size_t numThreads = boost::thread::hardware_concurrency();
     std::string iformat("bin");
-    std::vector<opt::StandardParameter<TcoordType>> params;
+    double rawDt = 0;
+    std::string evaluation("direct");
+    std::string domain("time");
+    std::string search("grid");
+    std::string gridMode("explicit");
+    std::string preparation("fused");
+    std::string derivativeName("central3");
+    double bnbTolerance = 0;
+    double fmin = 0;
+    double fmax = 0;
+    std::string oformat("text");
+    std::string kernelName("auto");
+    std::string modelName("cubic");
+    bool profileGain = false;
+    size_t mdBest = 0;
+    size_t batchSize = 0;
+    std::string precision("double");
+    std::string resultPrecision("double");
+    size_t precisionCheck = 100;
+    int refineLevels = 0;
+    size_t refineBest = 10;
+    double refineThreshold = 0;
+    size_t polishBest = 0;
+    size_t pruneTopK = 0;
+    size_t topK = 0;
+    bool stream = false;
+    bool noCache = false;
+    bool hugePages = false;
+    fs::path cacheDir(homeDir);
+    cacheDir /= ".optimize";
+    cacheDir /= "cache";
+    size_t cacheLimit = 4096;
+    int screenFactor = 0;
+    double screenMargin = 0.25;
+    double screenKeep = 0.01;
+    size_t screenCheck = 20;
+    fs::path polishFile;
+    std::vector<std::shared_ptr<TparameterType>> params;
 
     // declare only commandline options
     po::options_description generic("Commandline options");
@@ -155,7 +517,8 @@ int main(int iargc, char* argv[])
       ("overwrite,o", "Overwrite OUTFILE")
       ("config-file", po::value<fs::path>(&configFilePath)->default_value(
         defaultConfigFilePath), "Path to optcalex configuration file.")
-      ("linear,l", "Perform a search based on a linear model")
+      ("linear,l", "Perform a search based on a linear model "
+       "(same as '--model linear')")
       ;
 
     // declare both commandline and configuration file options
@@ -163,13 +526,117 @@ int main(int iargc, char* argv[])
         "Both Commandline and optcalex configuration file options");
     config.add_options()
       ("param,p",
-       po::value<std::vector<opt::StandardParameter<TcoordType>>>(
+       po::value<std::vector<std::shared_ptr<TparameterType>>>(
          &params)->required(),
        "Unknown parameter to search for.")
       ("threads,t", po::value<size_t>(&numThreads)->default_value(numThreads),
        "Number of threads to start for parallel computation")
+      ("model", po::value<std::string>(&modelName)->default_value(modelName),
+       "Seismometer model (either 'linear', 'cubic', 'quadratic-damping', "
+       "'odd' or 'product').")
       ("iformat", po::value<std::string>(&iformat)->default_value(iformat),
        "Format of input files (default: 'bin').")
+      ("dt", po::value<double>(&rawDt),
+       "Sampling interval of input files of the 'raw' format.")
+      ("evaluation",
+       po::value<std::string>(&evaluation)->default_value(evaluation),
+       "Evaluation mode of the misfit (either 'direct', 'gram' or "
+       "'projection').")
+      ("preparation",
+       po::value<std::string>(&preparation)->default_value(preparation),
+       "Preparation of derivatives and regressors (either 'fused' or "
+       "'reference').")
+      ("derivative",
+       po::value<std::string>(&derivativeName)->default_value(derivativeName),
+       "Derivative operator (either 'central3', 'central5', 'central7' or "
+       "'sgW[:P]').")
+      ("search", po::value<std::string>(&search)->default_value(search),
+       "Search strategy (either 'grid' or 'bnb').")
+      ("grid", po::value<std::string>(&gridMode)->default_value(gridMode),
+       "Parameter space grid (either 'explicit' or 'implicit').")
+      ("bnb-tolerance",
+       po::value<double>(&bnbTolerance)->default_value(bnbTolerance),
+       "Relative tolerance of the RMS misfit of the branch and bound "
+       "search.")
+      ("domain", po::value<std::string>(&domain)->default_value(domain),
+       "Domain the RMS misfit is computed in (either 'time' or 'freq').")
+      ("fmin", po::value<double>(&fmin)->default_value(fmin),
+       "Lower corner frequency of the passband in 'freq' domain (Hz).")
+      ("fmax", po::value<double>(&fmax)->default_value(fmax),
+       "Upper corner frequency of the passband in 'freq' domain (Hz, 0: "
+       "Nyquist frequency).")
+      ("gain", po::bool_switch(&profileGain),
+       "Solve for the gain of the calibration signal in 'projection' "
+       "evaluation mode.")
+      ("md-best", po::value<size_t>(&mdBest)->default_value(mdBest),
+       "Number of best nodes the MD misfit is computed for in 'gram' and "
+       "'projection' evaluation mode.")
+      ("kernel", po::value<std::string>(&kernelName)->default_value(kernelName),
+       "Misfit kernel (either 'auto', 'scalar', 'sse2', 'avx2' or 'avx512').")
+      ("batch", po::value<size_t>(&batchSize)->default_value(batchSize),
+       "Number of nodes evaluated together (0: evaluate node by node).")
+      ("precision",
+       po::value<std::string>(&precision)->default_value(precision),
+       "Precision of the misfit computation (either 'double' or 'float').")
+      ("result-precision",
+       po::value<std::string>(&resultPrecision)->default_value(
+         resultPrecision),
+       "Precision of the results stored by an implicit grid (either "
+       "'double' or 'float').")
+      ("precision-check",
+       po::value<size_t>(&precisionCheck)->default_value(precisionCheck),
+       "Number of nodes recomputed in double precision to report the "
+       "deviation of the single precision misfit.")
+      ("refine", po::value<int>(&refineLevels)->default_value(refineLevels),
+       "Number of levels of the adaptive grid refinement (0: search the "
+       "full grid).")
+      ("refine-best",
+       po::value<size_t>(&refineBest)->default_value(refineBest),
+       "Number of best cells refined per level.")
+      ("refine-threshold",
+       po::value<double>(&refineThreshold)->default_value(refineThreshold),
+       "Cells with an RMS misfit below the threshold are refined as well "
+       "(ignored if not positive).")
+      ("polish", po::value<size_t>(&polishBest)->default_value(polishBest),
+       "Number of best nodes used as starting points of a local "
+       "Levenberg-Marquardt optimization.")
+      ("polish-file", po::value<fs::path>(&polishFile),
+       "Filepath of the results of the local optimization (default: "
+       "OUTFILE.polish).")
+      ("prune-topk", po::value<size_t>(&pruneTopK)->default_value(pruneTopK),
+       "Abort the computation of nodes which cannot be among the K best "
+       "nodes (0: compute all nodes completely).")
+      ("top-k", po::value<size_t>(&topK)->default_value(topK),
+       "Write only the K best nodes sorted by their RMS misfit (0: write "
+       "all nodes). The memory used is independent of the grid size with "
+       "'--grid implicit' only.")
+      ("oformat", po::value<std::string>(&oformat)->default_value(oformat),
+       "Format of OUTFILE ('text', 'npy' or 'bin').")
+      ("stream", po::bool_switch(&stream),
+       "Write the nodes in the order of their completion while they are "
+       "computed.")
+      ("huge-pages", po::bool_switch(&hugePages),
+       "Back the regressor time series by transparent huge pages.")
+      ("no-cache", po::bool_switch(&noCache),
+       "Do not use the cache of prepared regressors.")
+      ("cache-dir", po::value<fs::path>(&cacheDir)->default_value(cacheDir),
+       "Directory of the cache of prepared regressors.")
+      ("cache-limit", po::value<size_t>(&cacheLimit)->default_value(cacheLimit),
+       "Size limit of the cache of prepared regressors in MB.")
+      ("screen", po::value<int>(&screenFactor)->default_value(screenFactor),
+       "Decimation factor of the screening of the nodes (0: compute all "
+       "nodes on the full data).")
+      ("screen-margin",
+       po::value<double>(&screenMargin)->default_value(screenMargin),
+       "Nodes whose screened RMS misfit exceeds the best one by less than "
+       "this fraction are computed on the full data.")
+      ("screen-keep",
+       po::value<double>(&screenKeep)->default_value(screenKeep),
+       "Fraction of best screened nodes computed on the full data anyway.")
+      ("screen-check",
+       po::value<size_t>(&screenCheck)->default_value(screenCheck),
+       "Number of eliminated nodes per grid recomputed on the full data to "
+       "validate the screening.")
       ("calib-in", po::value<fs::path>()->required(),
        "Filepath of calibration input signal file.")
       ("calib-out", po::value<fs::path>()->required(), 
@@ -267,87 +734,186 @@ int main(int iargc, char* argv[])
     {
       throw std::string("OUTFILE exists. Specify option 'overwrite'.");
     }
+    if (polishBest && polishFile.empty())
+    {
+      polishFile = outpath.string()+".polish";
+    }
+    if (polishBest && fs::exists(polishFile) && ! vm.count("overwrite"))
+    {
+      throw std::string("Polish file exists. Specify option 'overwrite'.");
+    }
     fs::path calibInfile(vm["calib-in"].as<fs::path>());
     fs::path calibOutfile(vm["calib-out"].as<fs::path>());
-
-    // check and sort unknown parameters
-    std::sort(params.begin(), params.end(),
-        [](opt::StandardParameter<TcoordType> const& p1,
-          opt::StandardParameter<TcoordType> const& p2) -> bool
-        {
-          return p1.getId() > p2.getId();
-        });
-    std::unique(params.begin(), params.end(),
-        [](opt::StandardParameter<TcoordType> const& p1,
-          opt::StandardParameter<TcoordType> const& p2) -> bool
-        {
-          return p1.getId() == p2.getId();
-        });
-    if(vm.count("linear"))
+    if ("direct" != evaluation && "gram" != evaluation &&
+        "projection" != evaluation)
     {
-      // now unknown parameters should be in the following order (linear)
-      // h  -> params.at(0)
-      // T0 -> params.at(1)
-      if (params.size() < 2 || params.at(0).getId() != "h" ||
-          params.at(1).getId() != "T0")
-      {
-        throw std::string("Illegal parameter specification.");
-      }
-    } else
+      throw std::string("Illegal evaluation mode '"+evaluation+"'.");
+    }
+    bool const direct = ("direct" == evaluation);
+    if ("time" != domain && "freq" != domain)
     {
-      if (params.size() != 4 || params.at(0).getId() != "c0" ||
-          params.at(1).getId() != "c1" || params.at(2).getId() != "h" ||
-          params.at(3).getId() != "T0")
-      {
-        throw std::string("Illegal parameter specification.");
-      }
-      // now unknown parameters should be in the following order (nonlinear)
-      // c0 -> params.at(0)
-      // c1 -> params.at(1)
-      // h  -> params.at(2)
-      // T0 -> params.at(3)
+      throw std::string("Illegal domain '"+domain+"'.");
+    }
+    bool const frequency = ("freq" == domain);
+    if (frequency && direct)
+    {
+      throw std::string(
+          "Frequency domain requires 'gram' or 'projection' evaluation mode.");
+    }
+    if (stream && (topK || refineLevels))
+    {
+      throw std::string(
+          "Streaming is not available with 'top-k' or 'refine'.");
+    }
+    if ("text" != oformat) { binaryFormat(oformat); }
+    if (pruneTopK && ! direct)
+    {
+      throw std::string("Pruning requires 'direct' evaluation mode.");
+    }
+    if (1 < screenFactor && ! direct)
+    {
+      throw std::string("Screening requires 'direct' evaluation mode.");
+    }
+    // the direct evaluation computes the MD misfit of all nodes anyway
+    if (mdBest && direct)
+    {
+      throw std::string(
+          "'md-best' requires 'gram' or 'projection' evaluation mode.");
+    }
+    if ("fused" != preparation && "reference" != preparation)
+    {
+      throw std::string("Illegal preparation '"+preparation+"'.");
+    }
+    DerivativeOperator const derivative(derivativeName);
+    if ("grid" != search && "bnb" != search)
+    {
+      throw std::string("Illegal search strategy '"+search+"'.");
+    }
+    bool const bnb = ("bnb" == search);
+    if (bnb && ("projection" == evaluation || refineLevels || stream ||
+          1 < screenFactor))
+    {
+      throw std::string("Branch and bound search is not available with "
+          "'projection' evaluation, 'refine', 'stream' or 'screen'.");
+    }
+    if ("explicit" != gridMode && "implicit" != gridMode)
+    {
+      throw std::string("Illegal grid '"+gridMode+"'.");
+    }
+    bool const implicit = ("implicit" == gridMode);
+    if (implicit && (refineLevels || stream || bnb || 1 < screenFactor))
+    {
+      throw std::string("Implicit grid is not available with 'refine', "
+          "'stream', 'bnb' or 'screen'.");
+    }
+    if ("double" != resultPrecision && "float" != resultPrecision)
+    {
+      throw std::string("Illegal result precision '"+resultPrecision+"'.");
     }
+    if ("double" != precision && "float" != precision)
+    {
+      throw std::string("Illegal precision '"+precision+"'.");
+    }
+    kernel::select(kernel::isaFromString(kernelName));
+    if (vm.count("verbose"))
+    {
+      cout << "optnonlin: Using '" << kernel::isaName(kernel::selected())
+        << "' misfit kernel." << endl;
+    }
+
+    if (vm.count("linear")) { modelName = "linear"; }
+    std::vector<std::string> const terms(model::terms(modelName));
 
-    // create shared_ptrs for unknown parameters
-    std::vector<std::shared_ptr<opt::StandardParameter<TcoordType>>> param_ptrs;
-    param_ptrs.reserve(5);
-    for (auto it(params.begin()); it != params.end(); ++it)
+    // unknown parameters of the model; if a parameter was specified more
+    // than once the first one is taken
+    std::vector<std::string> ids;
+    ids.push_back("h");
+    ids.push_back("T0");
+    // coefficients of the nonlinear terms are not gridded if profiled
+    for (size_t i=0; "projection" != evaluation && i<terms.size(); ++i)
+    {
+      ids.push_back(model::coefficientId(i));
+    }
+    std::vector<std::shared_ptr<TparameterType>> param_ptrs;
+    param_ptrs.reserve(ids.size());
+    for (auto cit(ids.cbegin()); cit != ids.cend(); ++cit)
     {
-      param_ptrs.push_back(std::shared_ptr<opt::StandardParameter<TcoordType>>(
-            new opt::StandardParameter<TcoordType>(*it)));
+      auto pit = std::find_if(params.cbegin(), params.cend(),
+          [&cit](std::shared_ptr<TparameterType> const& param) -> bool
+          {
+            return param->getId() == *cit;
+          });
+      if (pit == params.cend())
+      {
+        throw std::string("Missing parameter '"+*cit+"'.");
+      }
+      param_ptrs.push_back(*pit);
     }
 
-    // read data files
+    // read data files; mapped files must outlive the series referring to
+    // their samples
+    std::unique_ptr<MappedSeries> mappedIn;
+    std::unique_ptr<MappedSeries> mappedOut;
+    // cached regressors; must outlive the series referring to them
+    std::unique_ptr<CacheEntry> cached;
     datrw::Tdseries calibInSeries;
     datrw::Tdseries calibOutSeries;
     sff::WID2 wid2CalibIn;
     sff::WID2 wid2CalibOut;
+    if ("raw" == iformat && 0 >= rawDt)
     {
-#if BOOST_FILESYSTEM_VERSION == 2
-      std::ifstream ifs(calibInfile.string().c_str(), 
-          datrw::ianystream::openmode(iformat));
-#else
-      std::ifstream ifs(calibInfile.c_str(), 
-          datrw::ianystream::openmode(iformat));
-#endif
-      if (!ifs.good()) { throw std::string("Cannot open input file!"); }
-      datrw::ianystream is(ifs, iformat);    
-      is >> calibInSeries;
-      is >> wid2CalibIn;
+      throw std::string("Format 'raw' requires a sampling interval.");
     }
+    auto load = [&](fs::path const& path, std::unique_ptr<MappedSeries>& mapped,
+        datrw::Tdseries& series, sff::WID2& wid2)
     {
+      if ("raw" == iformat)
+      {
+        mapped.reset(new MappedSeries(path.string()));
+        series = mapped->series();
+        wid2 = mapped->wid2(rawDt);
+      } else
+      if ("seife" == iformat)
+      {
+        readSeife(path.string(), numThreads, series, wid2);
+      } else
+      {
 #if BOOST_FILESYSTEM_VERSION == 2
-      std::ifstream ifs(calibOutfile.string().c_str(), 
-          datrw::ianystream::openmode(iformat));
+        std::ifstream ifs(path.string().c_str(), 
+            datrw::ianystream::openmode(iformat));
 #else
-      std::ifstream ifs(calibOutfile.c_str(), 
-          datrw::ianystream::openmode(iformat));
+        std::ifstream ifs(path.c_str(), 
+            datrw::ianystream::openmode(iformat));
 #endif
-      if (!ifs.good()) { throw std::string("Cannot open input file!"); }
-      datrw::ianystream is(ifs, iformat);    
-      is >> calibOutSeries;
-      is >> wid2CalibOut;
+        if (!ifs.good()) { throw std::string("Cannot open input file!"); }
+        datrw::ianystream is(ifs, iformat);    
+        is >> series;
+        is >> wid2;
+      }
+    };
+    // read the input signal in a second thread
+    std::string loadError;
+    boost::thread loader([&]()
+        {
+          try
+          {
+            load(calibInfile, mappedIn, calibInSeries, wid2CalibIn);
+          }
+          catch (std::string e) { loadError = e; }
+          catch (std::exception& e) { loadError = e.what(); }
+          catch (...) { loadError = "Exception of unknown type!"; }
+        });
+    try
+    {
+      load(calibOutfile, mappedOut, calibOutSeries, wid2CalibOut);
+    }
+    catch (...)
+    {
+      loader.join();
+      throw;
     }
+    loader.join();
+    if (! loadError.empty()) { throw loadError; }
     // check data header consistency
     if (vm.count("verbose")) 
     { 
@@ -358,19 +924,148 @@ int main(int iargc, char* argv[])
     {
       throw std::string("Inconsistant time series header information.");
     }
-    // prepare data for computation
-    datrw::Tdseries* dif2Series = new datrw::Tdseries(calibOutSeries.size());
-    datrw::Tdseries* difSeries = new datrw::Tdseries(calibOutSeries.size());
-    datrw::Tdseries* squareSeries = 0;
-    datrw::Tdseries* cubeSeries = 0;
-    util::dif2(calibOutSeries, *dif2Series, wid2CalibIn.dt);
-    util::dif(calibOutSeries, *difSeries, wid2CalibIn.dt);
-    if(! vm.count("linear"))
+    // prepare data for computation; regressors are taken from the cache if
+    // they were prepared for the same input before
+    std::unique_ptr<FeatureCache> cache;
+    std::string cacheKey;
+    if (! noCache)
+    {
+      std::ostringstream settings;
+      settings << "model=" << modelName << ";dif=" << derivative.name()
+        << "-v2;prep="
+        << preparation << ";ld=" << sizeof(long double);
+      std::vector<datrw::Tdseries const*> inputs;
+      inputs.push_back(&calibInSeries);
+      inputs.push_back(&calibOutSeries);
+      // the cache is an optimization only; optnonlin continues without it
+      try
+      {
+        cache.reset(new FeatureCache(cacheDir, cacheLimit*1024*1024));
+        cacheKey = FeatureCache::key(inputs, wid2CalibIn.dt, settings.str());
+        cached.reset(cache->load(cacheKey));
+      }
+      catch (std::string e)
+      {
+        cerr << "WARNING: Cache not used: " << e << endl;
+        cache.reset();
+      }
+      catch (fs::filesystem_error& e)
+      {
+        cerr << "WARNING: Cache not used: " << e.what() << endl;
+        cache.reset();
+      }
+      // an entry without Gram matrix is recomputed if it is required
+      if (cached && (cached->count() !=
+            FeatureMatrix::featureColumn+terms.size() ||
+            cached->size() != size_t(calibOutSeries.size()) ||
+            ((! direct || polishBest || bnb) && ! frequency &&
+             ! cached->hasGram())))
+      {
+        cached.reset();
+      }
+    }
+    // derivatives and regressors of the nonlinear terms share a single
+    // aligned block of memory; cached regressors are used in place
+    std::unique_ptr<FeatureMatrix> const matrixPtr(cached ? cached->matrix() :
+        new FeatureMatrix(calibOutSeries.size(),
+          FeatureMatrix::featureColumn+terms.size(), hugePages));
+    FeatureMatrix& matrix(*matrixPtr);
+    datrw::Tdseries dif2Series(matrix.series(FeatureMatrix::dif2Column));
+    datrw::Tdseries difSeries(matrix.series(FeatureMatrix::difColumn));
+    std::vector<datrw::Tdseries> const& features = matrix.features();
+    if (cached)
+    {
+      if (vm.count("verbose"))
+      {
+        cout << "optnonlin: Using cached regressors " << cacheKey << " ..."
+          << endl;
+      }
+    } else
+    {
+      if (vm.count("verbose"))
+      {
+        cout << "optnonlin: Preparing derivatives and regressors ..." << endl;
+      }
+      if ("reference" == preparation)
+      {
+        if (derivative.isCentral3())
+        {
+          util::dif2(calibOutSeries, dif2Series, wid2CalibIn.dt);
+          util::dif(calibOutSeries, difSeries, wid2CalibIn.dt);
+        } else
+        {
+          derivative.apply(calibOutSeries, wid2CalibIn.dt, dif2Series,
+              difSeries);
+        }
+        model::prepare(modelName, calibOutSeries, matrix);
+      } else
+      {
+        model::prepareFused(modelName, calibOutSeries, wid2CalibIn.dt,
+            derivative, matrix, numThreads);
+      }
+    }
+    GramMatrix* gram = 0;
+    std::vector<double const*> columns;
+    if (! direct || polishBest || bnb)
+    {
+      columns.push_back(matrix.column(FeatureMatrix::dif2Column));
+      columns.push_back(matrix.column(FeatureMatrix::difColumn));
+      columns.push_back(kernel::samples(calibOutSeries));
+      for (size_t i=FeatureMatrix::featureColumn; i<matrix.count(); ++i)
+      {
+        columns.push_back(matrix.column(i));
+      }
+      columns.push_back(kernel::samples(calibInSeries));
+      if (frequency)
+      {
+        double const nyquist = 0.5/wid2CalibIn.dt;
+        size_t bins = 0;
+        if (vm.count("verbose"))
+        {
+          cout << "optnonlin: Computing spectra of regressors ..." << endl;
+        }
+        gram = new GramMatrix(spectrum::bandGram(columns,
+              calibInSeries.size(), wid2CalibIn.dt, fmin,
+              0 < fmax ? fmax : nyquist, &bins));
+        if (vm.count("verbose"))
+        {
+          cout << "optnonlin: Passband contains " << bins
+            << " frequency bins." << endl;
+        }
+      } else
+      if (cached)
+      {
+        gram = new GramMatrix(cached->gram());
+      } else
+      {
+        if (vm.count("verbose"))
+        {
+          cout << "optnonlin: Computing Gram matrix of regressors ..."
+            << endl;
+        }
+        gram = new GramMatrix(columns, calibInSeries.size());
+      }
+    }
+    if (cache && ! cached)
     {
-      squareSeries = new datrw::Tdseries(calibOutSeries.size());
-      cubeSeries = new datrw::Tdseries(calibOutSeries.size());
-      util::square(calibOutSeries, *squareSeries);
-      util::cube(calibOutSeries, *cubeSeries);
+      std::vector<datrw::Tdseries const*> prepared;
+      for (size_t i=0; i<matrix.count(); ++i)
+      {
+        prepared.push_back(&matrix.series(i));
+      }
+      // the cache holds the Gram matrix of the full time series only
+      try
+      {
+        cache->store(cacheKey, prepared, frequency ? 0 : gram);
+      }
+      catch (std::string e)
+      {
+        cerr << "WARNING: Cache entry not stored: " << e << endl;
+      }
+      catch (fs::filesystem_error& e)
+      {
+        cerr << "WARNING: Cache entry not stored: " << e.what() << endl;
+      }
     }
 
     // create global algorithm and set up parameter space
@@ -384,60 +1079,427 @@ int main(int iargc, char* argv[])
 
     // get parameter order of the builder and reorder parameters after creating
     // global algorithm
-    std::vector<int> order;
-    if (vm.count("linear"))
-    {
-      order = builder->getParameterOrder(3);
-    } else
-    {
-      order = builder->getParameterOrder(5);
-    }
+    std::vector<int> order(builder->getParameterOrder(param_ptrs.size()+1));
 
     // gridsearch algorithm
     std::unique_ptr<opt::GlobalAlgorithm<TcoordType, TresultType>> algo( 
       new opt::GridSearch<TcoordType, TresultType>(
         std::move(builder), numThreads));
 
-    // TODO TODO TODO TODO TODO
-    // IMPORTANT: check once again the order of the parameters
-    // TODO TODO TODO TODO TODO
-    // add reordered parameters
+    // add reordered parameters; the coordinates of the nodes are in the same
+    // order, so the visitors look up their coordinates by parameter id
+    std::vector<std::string> coordinateIds;
+    std::vector<std::shared_ptr<TparameterType>> ordered_ptrs;
     for (auto cit(order.cbegin()); cit != order.end(); ++cit)
     {
       algo->addParameter(param_ptrs[*cit]);
+      coordinateIds.push_back(param_ptrs[*cit]->getId());
+      ordered_ptrs.push_back(param_ptrs[*cit]);
     }
+    CoordinateMap const coordinates(coordinateIds);
 
-    opt::ParameterSpaceVisitor<TcoordType, TresultType>* app = 0;
-    if (vm.count("linear"))
+    // the direct application is used in 'gram' and 'projection' evaluation
+    // mode as well to compute the MD misfit of the best nodes
+    opt::ParameterSpaceVisitor<TcoordType, TresultType>* double_app = 0;
+    if ("projection" == evaluation)
     {
-      app = new LinApplication(calibInSeries, *dif2Series, *difSeries,
-          calibOutSeries, vm.count("verbose"));
+      double_app = new ProjectionApplication(*gram, columns,
+          calibInSeries.size(), coordinates, terms.size(), profileGain, true,
+          vm.count("verbose"));
     } else
     {
-      app = new NonLinApplication(calibInSeries, *dif2Series, *difSeries,
-          calibOutSeries, *squareSeries, *cubeSeries, vm.count("verbose"));
+      double_app = model::createApplication(modelName, calibInSeries, matrix,
+          calibOutSeries, coordinates, vm.count("verbose"));
+    }
+    opt::ParameterSpaceVisitor<TcoordType, TresultType>* direct_app =
+      double_app;
+    // single precision copies of the time series
+    std::vector<datrw::Tfseries*> floatSeries;
+    std::vector<datrw::Tfseries> floatFeatures;
+    auto toFloat = [&floatSeries](datrw::Tdseries const& series)
+      -> datrw::Tfseries const&
+    {
+      floatSeries.push_back(new datrw::Tfseries(series.size()));
+      util::convert(series, *floatSeries.back());
+      return *floatSeries.back();
+    };
+    if ("float" == precision && direct)
+    {
+      if (vm.count("verbose"))
+      {
+        cout << "optnonlin: Converting time series to single precision ..."
+          << endl;
+      }
+      for (auto cit(features.cbegin()); cit != features.cend(); ++cit)
+      {
+        floatFeatures.push_back(toFloat(*cit));
+      }
+      direct_app = model::createApplication(modelName, toFloat(calibInSeries),
+          toFloat(dif2Series), toFloat(difSeries), toFloat(calibOutSeries),
+          floatFeatures, coordinates, vm.count("verbose"));
+    }
+    opt::ParameterSpaceVisitor<TcoordType, TresultType>* app = direct_app;
+    // lowpass filtered and decimated copies of the time series
+    std::vector<datrw::Tdseries*> coarseSeries;
+    std::vector<datrw::Tdseries> coarseFeatures;
+    auto decimated = [&coarseSeries, screenFactor](
+        datrw::Tdseries const& series) -> datrw::Tdseries const&
+    {
+      coarseSeries.push_back(new datrw::Tdseries(
+            (series.size()+screenFactor-1)/screenFactor));
+      util::decimate(series, *coarseSeries.back(), screenFactor);
+      return *coarseSeries.back();
+    };
+    opt::ParameterSpaceVisitor<TcoordType, TresultType>* coarse_app = 0;
+    std::unique_ptr<ScreeningVisitor> screening;
+    if (1 < screenFactor)
+    {
+      if (vm.count("verbose"))
+      {
+        cout << "optnonlin: Decimating time series by " << screenFactor
+          << " for screening ..." << endl;
+      }
+      for (auto cit(features.cbegin()); cit != features.cend(); ++cit)
+      {
+        coarseFeatures.push_back(decimated(*cit));
+      }
+      coarse_app = model::createApplication(modelName,
+          decimated(calibInSeries), decimated(dif2Series),
+          decimated(difSeries), decimated(calibOutSeries), coarseFeatures,
+          coordinates, vm.count("verbose"));
+      screening.reset(new ScreeningVisitor(*coarse_app, *direct_app,
+            screenMargin, screenKeep));
+    }
+    if ("gram" == evaluation)
+    {
+      app = new GramApplication(*gram, coordinates, terms.size(),
+          vm.count("verbose"));
+    } else
+    if ("projection" == evaluation)
+    {
+      app = new ProjectionApplication(*gram, columns, calibInSeries.size(),
+          coordinates, terms.size(), profileGain, false, vm.count("verbose"));
     }
 
-    algo->constructParameterSpace();
-    if (vm.count("verbose"))
+    std::unique_ptr<TopKThreshold> pruning;
+    if (pruneTopK)
     {
-      if (vm.count("linear"))
+      pruning.reset(new TopKThreshold(pruneTopK));
+      dynamic_cast<BatchVisitor&>(*direct_app).setPruning(pruning.get());
+    }
+
+    // the nodes of the refinement levels are kept anyway; thus the best
+    // nodes are collected during the computation of a single grid only
+    std::unique_ptr<TtopKType> best;
+    if (topK && 0 == refineLevels)
+    {
+      best.reset(new TtopKType(topK,
+            [](TresultType const& result) -> double
+            {
+              return result.isPruned() ?
+                std::numeric_limits<double>::infinity() :
+                result.getRmsMisfit();
+            }));
+    }
+
+    std::ofstream ofs(outpath.string().c_str(), "text" == oformat ?
+        std::ios::out : std::ios::out | std::ios::binary);
+
+    // values of a result as appended by OptResult::appendValues()
+    std::vector<std::string> resultColumns;
+    resultColumns.push_back("md");
+    resultColumns.push_back("rms");
+    if ("projection" == evaluation)
+    {
+      for (size_t i=0; i<terms.size(); ++i)
       {
-        cout << "optnonlin: Sending linear application through parameter space "
-          << "grid ..." << endl;
+        resultColumns.push_back(model::coefficientId(i));
+      }
+      if (profileGain) { resultColumns.push_back("gain"); }
+    }
+    resultColumns.push_back("pruned");
+
+    // binary result table
+    std::unique_ptr<BinaryTable> table;
+    if ("text" != oformat)
+    {
+      std::vector<std::string> names;
+      if (stream) { names.push_back("index"); }
+      names.insert(names.end(), coordinateIds.begin(), coordinateIds.end());
+      if (refineLevels) { names.push_back("level"); }
+      names.insert(names.end(), resultColumns.begin(), resultColumns.end());
+      table.reset(new BinaryTable(ofs, binaryFormat(oformat), names));
+    }
+
+    // write the nodes by a dedicated thread while they are computed
+    std::unique_ptr<GridIndex<TcoordType>> gridIndex;
+    std::unique_ptr<TsinkType> sink;
+    if (stream)
+    {
+      std::vector<std::vector<TcoordType>> axes;
+      for (auto cit(ordered_ptrs.cbegin()); cit != ordered_ptrs.cend(); ++cit)
+      {
+        axes.push_back(samplingPoints(**cit));
+      }
+      gridIndex.reset(new GridIndex<TcoordType>(axes));
+      sink.reset(new TsinkType(ofs, *gridIndex,
+            [&table](std::ostream& os, TsinkType::Trecord const& record)
+            {
+              if (table)
+              {
+                std::vector<double> row(1, record.index);
+                row.insert(row.end(), record.coordinates.begin(),
+                    record.coordinates.end());
+                record.result.appendValues(row);
+                table->write(row);
+                return;
+              }
+              os << std::setw(10) << std::right << record.index << " ";
+              for (auto cit(record.coordinates.cbegin());
+                  cit != record.coordinates.cend(); ++cit)
+              {
+                os << std::setw(12) << std::fixed << std::left << *cit << " ";
+              }
+              os << "    " << std::setw(12) << std::fixed << std::left <<
+                record.result << "\n";
+            }, TsinkType::Tformat(),
+            // the row count of npy tables is updated on each flush
+            [&table](std::ostream& os)
+            {
+              if (table) { table->flush(); }
+              else { os.flush(); }
+            }));
+    }
+
+    // send the application through the parameter space of a grid search
+    auto evaluate = [&](opt::GlobalAlgorithm<TcoordType, TresultType>& grid)
+    {
+      if (screening) { screening->screen(grid); }
+      if (pruning || (batchSize && direct))
+      {
+        BatchVisitor* visitor = screening ? screening.get() :
+          &dynamic_cast<BatchVisitor&>(*direct_app);
+        std::unique_ptr<BatchVisitor> collector;
+        if (best) { collector.reset(new TopKBatchVisitor(*visitor, *best)); }
+        if (sink) { collector.reset(new SinkBatchVisitor(*visitor, *sink)); }
+        if (collector) { visitor = collector.get(); }
+        executeBatched(grid, *visitor, std::max(batchSize, size_t(1)),
+            numThreads, static_cast<bool>(pruning));
+      } else
+      {
+        opt::ParameterSpaceVisitor<TcoordType, TresultType>* visitor = app;
+        if (screening) { visitor = screening.get(); }
+        std::unique_ptr<opt::ParameterSpaceVisitor<TcoordType, TresultType>>
+          collector;
+        if (best)
+        {
+          collector.reset(
+              new TopKVisitor<TcoordType, TresultType>(*visitor, *best));
+        }
+        if (sink)
+        {
+          collector.reset(
+              new SinkVisitor<TcoordType, TresultType>(*visitor, *sink));
+        }
+        if (collector) { visitor = collector.get(); }
+        grid.execute(*visitor);
+      }
+      if (screening) { screening->check(grid, screenCheck); }
+    };
+    // evaluate a list of nodes in a single pass; used by the refinement
+    // which neither collects the best nodes nor streams
+    auto evaluateNodes = [&](std::vector<TnodeType*> const& nodes)
+    {
+      if (screening) { screening->screen(nodes, numThreads); }
+      std::unique_ptr<BatchVisitor> adaptor;
+      BatchVisitor* visitor = screening.get();
+      size_t batch = 1;
+      if (pruning || (batchSize && direct))
+      {
+        if (! visitor)
+        {
+          visitor = &dynamic_cast<BatchVisitor&>(*direct_app);
+        }
+        batch = std::max(batchSize, size_t(1));
       } else
       {
-        cout << "optnonlin: Sending nonlinear application through parameter "
-          << "space grid ..." << endl;
+        adaptor.reset(new NodeBatchVisitor(screening ?
+              static_cast<opt::ParameterSpaceVisitor<TcoordType,
+              TresultType>&>(*screening) : *app));
+        visitor = adaptor.get();
+      }
+      executeBatched(nodes, *visitor, batch, numThreads,
+          static_cast<bool>(pruning));
+      if (screening) { screening->check(nodes, screenCheck); }
+    };
+
+    std::unique_ptr<AdaptiveRefinement> refinement;
+    std::unique_ptr<BnbResult> bnbResult;
+    // implicit grid and its best nodes
+    std::unique_ptr<ImplicitGrid> implicitGrid;
+    std::vector<std::unique_ptr<TnodeType>> implicitNodes;
+    if (bnb)
+    {
+      if (vm.count("verbose"))
+      {
+        cout << "optnonlin: Searching grid minimum by branch and bound ..."
+          << endl;
+      }
+      BranchAndBound const searcher(*gram, ordered_ptrs, coordinates,
+          terms.size(), bnbTolerance, numThreads);
+      bnbResult.reset(new BnbResult(searcher.search()));
+      cout << "optnonlin: Branch and bound evaluated " << bnbResult->boxes
+        << " boxes (" << bnbResult->pruned << " discarded); RMS misfit "
+        << bnbResult->rms << ", lower bound " << bnbResult->bound << endl;
+    } else
+    if (0 < refineLevels)
+    {
+      if (vm.count("verbose"))
+      {
+        cout << "optnonlin: Sending application of model '" << modelName
+          << "' through " << refineLevels << " refinement levels ..." << endl;
+      }
+      // cells are defined by the stepwidth of linear axes
+      std::vector<std::shared_ptr<TlinearParameterType>> linear_ptrs;
+      for (auto cit(ordered_ptrs.cbegin()); cit != ordered_ptrs.cend(); ++cit)
+      {
+        linear_ptrs.push_back(
+            std::dynamic_pointer_cast<TlinearParameterType>(*cit));
+        if (! linear_ptrs.back())
+        {
+          throw std::string("Refinement requires linear parameter axes.");
+        }
+      }
+      refinement.reset(new AdaptiveRefinement(linear_ptrs, refineLevels,
+            refineBest, refineThreshold));
+      refinement->execute(evaluateNodes, vm.count("verbose"));
+    } else
+    if (implicit)
+    {
+      std::vector<std::vector<TcoordType>> axes;
+      for (auto cit(ordered_ptrs.cbegin()); cit != ordered_ptrs.cend(); ++cit)
+      {
+        axes.push_back(samplingPoints(**cit));
+      }
+      implicitGrid.reset(new ImplicitGrid(axes, resultColumns,
+            "float" == resultPrecision));
+      if (vm.count("verbose"))
+      {
+        cout << "optnonlin: Sending application of model '" << modelName
+          << "' through implicit grid of " << implicitGrid->size()
+          << " nodes (" << implicitGrid->store().bytes()
+          << " bytes of results) ..." << endl;
+      }
+      implicitGrid->execute(*app, std::max(batchSize, size_t(1)),
+          numThreads);
+      // the best nodes are selected from the result store and recomputed
+      // to recover their results in full precision
+      if (best)
+      {
+        std::vector<size_t> const indices(implicitGrid->best(topK));
+        for (auto cit(indices.cbegin()); cit != indices.cend(); ++cit)
+        {
+          implicitNodes.push_back(implicitGrid->node(*cit));
+          (*app)(implicitNodes.back().get());
+          best->offer(implicitNodes.back().get());
+        }
+      }
+    } else
+    {
+      algo->constructParameterSpace();
+      if (vm.count("verbose"))
+      {
+        cout << "optnonlin: Sending application of model '" << modelName
+          << "' through parameter space grid ..." << endl;
       }
+      evaluate(*algo);
     }
-    algo->execute(*app);
 
-    // collect results and write to outpath
-    std::ofstream ofs(outpath.string().c_str());
-    opt::Iterator<TcoordType, TresultType> it = 
-      algo->getParameterSpace().createIterator(opt::ForwardNodeIter);
+    if (! direct && mdBest && ! refinement && ! bnbResult)
+    {
+      if (vm.count("verbose"))
+      {
+        cout << "optnonlin: Computing MD misfit of the " << mdBest
+          << " best nodes ..." << endl;
+      }
+      std::vector<opt::Node<TcoordType, TresultType>*> nodes;
+      std::vector<size_t> indices;
+      if (best)
+      {
+        nodes = best->sorted();
+        mdBest = std::min(mdBest, nodes.size());
+      } else
+      if (implicitGrid)
+      {
+        indices = implicitGrid->best(mdBest);
+        for (auto cit(indices.cbegin()); cit != indices.cend(); ++cit)
+        {
+          implicitNodes.push_back(implicitGrid->node(*cit));
+          nodes.push_back(implicitNodes.back().get());
+        }
+        mdBest = nodes.size();
+      } else
+      {
+        opt::Iterator<TcoordType, TresultType> nit = 
+          algo->getParameterSpace().createIterator(opt::ForwardNodeIter);
+        for (nit.first(); !nit.isDone(); ++nit) { nodes.push_back(*nit); }
+        mdBest = std::min(mdBest, nodes.size());
+        std::partial_sort(nodes.begin(), nodes.begin()+mdBest, nodes.end(),
+            [](opt::Node<TcoordType, TresultType> const* n1,
+              opt::Node<TcoordType, TresultType> const* n2) -> bool
+            {
+              return n1->getResultData().getRmsMisfit() <
+                n2->getResultData().getRmsMisfit();
+            });
+      }
+      for (size_t i=0; i<mdBest; ++i)
+      {
+        (*direct_app)(nodes[i]);
+        if (sink)
+        {
+          sink->push(nodes[i]->getCoordinates(), nodes[i]->getResultData());
+        }
+        if (! indices.empty())
+        {
+          implicitGrid->keep(indices[i], nodes[i]->getResultData());
+        }
+      }
+    }
 
+    if (screening) { screening->report(cout); }
+
+    if (direct_app != double_app && precisionCheck && ! refinement &&
+        ! bnbResult && ! implicit)
+    {
+      // recompute sampled nodes in double precision and restore the single
+      // precision results afterwards
+      std::vector<opt::Node<TcoordType, TresultType>*> nodes;
+      opt::Iterator<TcoordType, TresultType> nit = 
+        algo->getParameterSpace().createIterator(opt::ForwardNodeIter);
+      for (nit.first(); !nit.isDone(); ++nit) { nodes.push_back(*nit); }
+      size_t const step = std::max(size_t(1), nodes.size()/precisionCheck);
+      size_t checked = 0;
+      double md_deviation = 0;
+      double rms_deviation = 0;
+      for (size_t i=0; i<nodes.size(); i+=step)
+      {
+        TresultType const float_result(nodes[i]->getResultData());
+        if (float_result.isPruned()) { continue; }
+        ++checked;
+        (*double_app)(nodes[i]);
+        TresultType const& double_result(nodes[i]->getResultData());
+        md_deviation = std::max(md_deviation, fabs(
+              float_result.getMdMisfit()-double_result.getMdMisfit()));
+        rms_deviation = std::max(rms_deviation, fabs(
+              float_result.getRmsMisfit()-double_result.getRmsMisfit()));
+        nodes[i]->setResultData(float_result);
+      }
+      cout << "optnonlin: Maximum deviation of single from double precision "
+        << "on " << checked << " nodes: MD misfit " << md_deviation
+        << ", RMS misfit " << rms_deviation << endl;
+    }
+
+    // collect results and write to outpath
     if (vm.count("verbose"))
     {
       cout << "optnonlin: Collecting results from parameter space grid ..."
@@ -446,21 +1508,258 @@ int main(int iargc, char* argv[])
         << endl;
     }
 
-    for (it.first(); !it.isDone(); ++it)
+    if (sink)
+    {
+      sink->close();
+    } else
+    if (bnbResult)
     {
-      std::vector<TcoordType> const& c = (*it)->getCoordinates();
-      for (std::vector<TcoordType>::const_iterator cit(c.begin());
-          cit != c.end(); ++cit)
+      TresultType const result(std::numeric_limits<double>::quiet_NaN(),
+          bnbResult->rms);
+      if (table)
+      {
+        std::vector<double> row(bnbResult->coordinates);
+        result.appendValues(row);
+        table->write(row);
+      } else
+      {
+        for (auto cit(bnbResult->coordinates.cbegin());
+            cit != bnbResult->coordinates.cend(); ++cit)
+        {
+          ofs << std::setw(12) << std::fixed << std::left << *cit << " ";
+        }
+        ofs << "    " << std::setw(12) << std::fixed << std::left << result
+          << endl;
+      }
+    } else
+    if (refinement)
+    {
+      std::vector<RefinedNode> nodes(refinement->nodes());
+      if (topK)
+      {
+        std::sort(nodes.begin(), nodes.end(),
+            [](RefinedNode const& n1, RefinedNode const& n2) -> bool
+            {
+              if (n1.result.isPruned() != n2.result.isPruned())
+              {
+                return n2.result.isPruned();
+              }
+              return n1.result.getRmsMisfit() < n2.result.getRmsMisfit();
+            });
+        nodes.resize(std::min(topK, nodes.size()));
+      }
+      for (auto nit(nodes.cbegin()); nit != nodes.cend(); ++nit)
+      {
+        if (table)
+        {
+          std::vector<double> row(nit->coordinates);
+          row.push_back(nit->level);
+          nit->result.appendValues(row);
+          table->write(row);
+          continue;
+        }
+        for (auto cit(nit->coordinates.cbegin());
+            cit != nit->coordinates.cend(); ++cit)
+        {
+          ofs << std::setw(12) << std::fixed << std::left << *cit << " ";
+        }
+        ofs << std::setw(4) << std::right << nit->level;
+        ofs << "    " << std::setw(12) << std::fixed << std::left <<
+          nit->result << endl;
+      }
+    } else
+    {
+      auto writeRow = [&ofs, &table](std::vector<TcoordType> const& c,
+          TresultType const& result)
+      {
+        if (table)
+        {
+          std::vector<double> row(c);
+          result.appendValues(row);
+          table->write(row);
+          return;
+        }
+        for (std::vector<TcoordType>::const_iterator cit(c.begin());
+            cit != c.end(); ++cit)
+        {
+          ofs << std::setw(12) << std::fixed << std::left << *cit << " ";
+        }
+        ofs << "    " << std::setw(12) << std::fixed << std::left <<
+          result << endl;
+      };
+      auto write = [&writeRow](
+          opt::Node<TcoordType, TresultType> const* node)
+      {
+        writeRow(node->getCoordinates(), node->getResultData());
+      };
+      if (best)
+      {
+        std::vector<opt::Node<TcoordType, TresultType>*> const nodes(
+            best->sorted());
+        std::for_each(nodes.begin(), nodes.end(), write);
+      } else
+      if (implicitGrid)
+      {
+        // rows are read from the result store
+        std::vector<TcoordType> c;
+        for (size_t i=0; i<implicitGrid->size(); ++i)
+        {
+          implicitGrid->coordinates(i, c);
+          writeRow(c, implicitGrid->result(i));
+        }
+      } else
       {
-        ofs << std::setw(12) << std::fixed << std::left << *cit << " ";
+        opt::Iterator<TcoordType, TresultType> it = 
+          algo->getParameterSpace().createIterator(opt::ForwardNodeIter);
+        for (it.first(); !it.isDone(); ++it) { write(*it); }
+      }
+    }
+    if (table)
+    {
+      table->finish();
+      if (BinaryTable::bin == binaryFormat(oformat))
+      {
+        std::ofstream cfs((outpath.string()+".columns").c_str());
+        table->describe(cfs);
+      }
+    }
+
+    if (polishBest)
+    {
+      // collect starting points
+      std::vector<RefinedNode> candidates;
+      if (refinement)
+      {
+        candidates = refinement->nodes();
+      } else
+      if (bnbResult)
+      {
+        RefinedNode node;
+        node.coordinates = bnbResult->coordinates;
+        node.result = TresultType(std::numeric_limits<double>::quiet_NaN(),
+            bnbResult->rms);
+        node.level = 0;
+        candidates.push_back(node);
+      } else
+      {
+        auto collect = [&candidates](
+            opt::Node<TcoordType, TresultType> const* n)
+        {
+          RefinedNode node;
+          node.coordinates = n->getCoordinates();
+          node.result = n->getResultData();
+          node.level = 0;
+          candidates.push_back(node);
+        };
+        if (best)
+        {
+          std::vector<opt::Node<TcoordType, TresultType>*> const nodes(
+              best->sorted());
+          std::for_each(nodes.begin(), nodes.end(), collect);
+        } else
+        if (implicitGrid)
+        {
+          std::vector<size_t> const indices(implicitGrid->best(polishBest));
+          for (auto cit(indices.cbegin()); cit != indices.cend(); ++cit)
+          {
+            // recomputed to start from the profiled parameters in full
+            // precision
+            std::unique_ptr<TnodeType> const n(implicitGrid->node(*cit));
+            (*app)(n.get());
+            RefinedNode node;
+            node.coordinates = n->getCoordinates();
+            node.result = n->getResultData();
+            node.level = 0;
+            candidates.push_back(node);
+          }
+        } else
+        {
+          opt::Iterator<TcoordType, TresultType> nit = 
+            algo->getParameterSpace().createIterator(opt::ForwardNodeIter);
+          for (nit.first(); !nit.isDone(); ++nit) { collect(*nit); }
+        }
+      }
+      polishBest = std::min(polishBest, candidates.size());
+      std::partial_sort(candidates.begin(), candidates.begin()+polishBest,
+          candidates.end(),
+          [](RefinedNode const& n1, RefinedNode const& n2) -> bool
+          {
+            if (n1.result.isPruned() != n2.result.isPruned())
+            {
+              return n2.result.isPruned();
+            }
+            return n1.result.getRmsMisfit() < n2.result.getRmsMisfit();
+          });
+      if (vm.count("verbose"))
+      {
+        cout << "optnonlin: Polishing the " << polishBest << " best nodes ..."
+          << endl;
+      }
+
+      LevenbergMarquardt lm(*gram, columns, calibInSeries.size(),
+          profileGain);
+      std::ofstream pfs(polishFile.string().c_str());
+      pfs << "#" << std::setw(11) << std::right << "h" << " "
+        << std::setw(12) << std::right << "T0" << " ";
+      for (size_t i=0; i<terms.size(); ++i)
+      {
+        pfs << std::setw(12) << std::right << model::coefficientId(i) << " ";
+      }
+      if (profileGain) { pfs << std::setw(12) << std::right << "gain" << " "; }
+      pfs << std::setw(12) << std::right << "MD misfit" << " "
+        << std::setw(12) << std::right << "RMS misfit" << " "
+        << std::setw(6) << std::right << "iter" << " "
+        << std::setw(4) << std::right << "conv" << " "
+        << std::setw(5) << std::right << "stall" << endl;
+      for (size_t k=0; k<polishBest; ++k)
+      {
+        // starting point from the coordinates or the profiled parameters
+        std::vector<TcoordType> const& c = candidates[k].coordinates;
+        std::vector<double> const& profiled =
+          candidates[k].result.getParameters();
+        std::vector<double> start;
+        start.push_back(c[coordinates["h"]]);
+        start.push_back(c[coordinates["T0"]]);
+        for (size_t i=0; i<terms.size(); ++i)
+        {
+          std::string const id(model::coefficientId(i));
+          start.push_back(coordinates.contains(id) ? c[coordinates[id]] :
+              profiled.at(i));
+        }
+        if (profileGain)
+        {
+          start.push_back(profiled.size() > terms.size() ?
+              profiled[terms.size()] : 1.);
+        }
+
+        PolishResult const result(lm.polish(start));
+        for (auto cit(result.parameters.cbegin());
+            cit != result.parameters.cend(); ++cit)
+        {
+          pfs << std::setw(12) << std::fixed << std::right << *cit << " ";
+        }
+        pfs << std::setw(12) << std::fixed << std::right << result.md << " "
+          << std::setw(12) << std::fixed << std::right << result.rms << " "
+          << std::setw(6) << std::right << result.iterations << " "
+          << std::setw(4) << std::right << result.converged << " "
+          << std::setw(5) << std::right << result.stalled << endl;
       }
-      ofs << "    " << std::setw(12) << std::fixed << std::left <<
-        (*it)->getResultData() << endl;
     }
 
     // clean up
-    delete app;
-    delete dif2Series; delete difSeries; delete squareSeries; delete cubeSeries;
+    if (app != direct_app) { delete app; }
+    if (direct_app != double_app) { delete direct_app; }
+    delete double_app;
+    delete coarse_app;
+    for (auto it(coarseSeries.begin()); it != coarseSeries.end(); ++it)
+    {
+      delete *it;
+    }
+    for (auto it(floatSeries.begin()); it != floatSeries.end(); ++it)
+    {
+      delete *it;
+    }
+    delete gram;
 
   }
   catch (std::string e) 
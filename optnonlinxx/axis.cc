@@ -0,0 +1,87 @@
+/*! \file axis.cc
+ * \brief Implementation of non-uniform parameter space axes.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Implementation of non-uniform parameter space axes.
+ *
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "axis.h"
+#include "../commonxx/gridindex.h"
+
+/* -------------------------------------------------------------------------- */
+ListParameter::ListParameter(std::string const& id,
+    std::vector<TcoordType> points) : TparameterType(id), Mpoints(points)
+{
+  if (Mpoints.empty())
+  {
+    throw std::string("Empty list of values of parameter '"+id+"'.");
+  }
+  std::sort(Mpoints.begin(), Mpoints.end());
+  Mpoints.erase(std::unique(Mpoints.begin(), Mpoints.end()), Mpoints.end());
+} // ListParameter::ListParameter
+
+/* -------------------------------------------------------------------------- */
+std::vector<TcoordType> logarithmicAxis(TcoordType start, TcoordType end,
+    size_t n)
+{
+  if (0 >= start || 0 >= end || 2 > n)
+  {
+    throw std::string("Illegal logarithmic axis.");
+  }
+  std::vector<TcoordType> retval;
+  double const first = log(start);
+  double const step = (log(end)-first)/(n-1);
+  for (size_t i=0; i<n; ++i)
+  {
+    // the boundaries are kept exactly
+    retval.push_back(0 == i ? start : n-1 == i ? end : exp(first+i*step));
+  }
+  return retval;
+} // function logarithmicAxis
+
+/* -------------------------------------------------------------------------- */
+std::vector<TcoordType> samplingPoints(TparameterType const& param)
+{
+  TlinearParameterType const* linear =
+    dynamic_cast<TlinearParameterType const*>(&param);
+  if (linear)
+  {
+    return regularAxis(linear->getStart(), linear->getEnd(),
+        linear->getDelta());
+  }
+  return param.getSamplingPoints();
+} // function samplingPoints
+
+/* ----- END OF axis.cc  ----- */
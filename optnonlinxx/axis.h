@@ -0,0 +1,101 @@
+/*! \file axis.h
+ * \brief Declaration of non-uniform parameter space axes.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Declaration of non-uniform parameter space axes. Besides of the
+ * linear axes of \a liboptimizexx standard parameters unknown parameters
+ * may be sampled at logarithmically spaced values or at an explicit list of
+ * values. Both are \a liboptimizexx parameters, so the parameter space is
+ * set up by the usual parameter space builder.
+ *
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <optimizexx/parameter.h>
+#include "types.h"
+
+#ifndef _OPTNONLIN_AXIS_H_
+#define _OPTNONLIN_AXIS_H_
+
+namespace opt = optimize;
+
+//! unknown parameter of an optnonlin parameter space
+typedef opt::Parameter<TcoordType> TparameterType;
+//! unknown parameter with a linear axis
+typedef opt::StandardParameter<TcoordType> TlinearParameterType;
+
+/*!
+ * unknown parameter sampled at an explicit list of values
+ */
+class ListParameter : public TparameterType
+{
+  public:
+    /*!
+     * constructor
+     *
+     * \param id id of the parameter
+     * \param points sampling points; they are sorted and duplicates are
+     * removed
+     */
+    ListParameter(std::string const& id, std::vector<TcoordType> points);
+    //! sampling points in ascending order
+    virtual std::vector<TcoordType> const& getSamplingPoints() const
+    {
+      return Mpoints;
+    }
+
+  private:
+    //! sampling points
+    std::vector<TcoordType> Mpoints;
+
+}; // class ListParameter
+
+/*!
+ * logarithmically spaced values
+ *
+ * \param start first value (positive)
+ * \param end last value (positive)
+ * \param n number of values (at least 2)
+ */
+std::vector<TcoordType> logarithmicAxis(TcoordType start, TcoordType end,
+    size_t n);
+
+/*!
+ * sampling points of an unknown parameter in ascending order
+ */
+std::vector<TcoordType> samplingPoints(TparameterType const& param);
+
+#endif // include guard
+
+/* ----- END OF axis.h  ----- */
@@ -0,0 +1,160 @@
+/*! \file batch.cc
+ * \brief Implementation of the batched evaluation of parameter space nodes.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Implementation of the batched evaluation of parameter space
+ * nodes.
+ *
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  Interleaved node order.
+ * 16/10/2026  V0.3  Provide TopKBatchVisitor.
+ * 16/10/2026  V0.4  Provide SinkBatchVisitor.
+ *
+ * ============================================================================
+ */
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+#include <optimizexx/iterator.h>
+#include "batch.h"
+
+/* -------------------------------------------------------------------------- */
+namespace
+{
+  //! dispenses the batches to the worker threads
+  class BatchQueue
+  {
+    public:
+      BatchQueue(std::vector<TnodeType*>& nodes, size_t batch_size) :
+        Mnodes(nodes), MbatchSize(batch_size), Mnext(0)
+      { }
+      //! fetch next batch; returns false if all batches are dispensed
+      bool next(TnodeType* const*& first, int& count)
+      {
+        boost::mutex::scoped_lock lock(Mmutex);
+        if (Mnext >= Mnodes.size()) { return false; }
+        first = &Mnodes[Mnext];
+        count = std::min(MbatchSize, Mnodes.size()-Mnext);
+        Mnext += count;
+        return true;
+      }
+    private:
+      std::vector<TnodeType*>& Mnodes;
+      size_t const MbatchSize;
+      size_t Mnext;
+      boost::mutex Mmutex;
+  }; // class BatchQueue
+
+  //! worker thread function
+  void work(BatchQueue& queue, BatchVisitor& visitor)
+  {
+    TnodeType* const* first = 0;
+    int count = 0;
+    while (queue.next(first, count)) { visitor.visitBatch(first, count); }
+  }
+} // namespace (unnamed)
+
+/* -------------------------------------------------------------------------- */
+void TopKBatchVisitor::visitBatch(TnodeType* const* nodes, int count)
+{
+  Mvisitor.visitBatch(nodes, count);
+  for (int i=0; i<count; ++i) { Mresults.offer(nodes[i]); }
+} // function TopKBatchVisitor::visitBatch
+
+/* -------------------------------------------------------------------------- */
+void SinkBatchVisitor::visitBatch(TnodeType* const* nodes, int count)
+{
+  Mvisitor.visitBatch(nodes, count);
+  for (int i=0; i<count; ++i)
+  {
+    Msink.push(nodes[i]->getCoordinates(), nodes[i]->getResultData());
+  }
+} // function SinkBatchVisitor::visitBatch
+
+/* -------------------------------------------------------------------------- */
+std::vector<TnodeType*> collectNodes(
+    opt::GlobalAlgorithm<TcoordType, TresultType>& algo)
+{
+  std::vector<TnodeType*> retval;
+  opt::Iterator<TcoordType, TresultType> it =
+    algo.getParameterSpace().createIterator(opt::ForwardNodeIter);
+  for (it.first(); !it.isDone(); ++it) { retval.push_back(*it); }
+  return retval;
+} // function collectNodes
+
+/* -------------------------------------------------------------------------- */
+void executeBatched(opt::GlobalAlgorithm<TcoordType, TresultType>& algo,
+    BatchVisitor& visitor, size_t batch_size, size_t num_threads,
+    bool interleave)
+{
+  executeBatched(collectNodes(algo), visitor, batch_size, num_threads,
+      interleave);
+} // function executeBatched
+
+/* -------------------------------------------------------------------------- */
+void executeBatched(std::vector<TnodeType*> nodes, BatchVisitor& visitor,
+    size_t batch_size, size_t num_threads, bool interleave)
+{
+  if (0 == batch_size) { throw std::string("Illegal batch size."); }
+  if (0 == num_threads) { num_threads = 1; }
+
+  if (interleave && nodes.size() > 1)
+  {
+    size_t step = 1;
+    while (step < nodes.size()) { step *= 2; }
+    std::vector<TnodeType*> interleaved;
+    interleaved.reserve(nodes.size());
+    std::vector<bool> taken(nodes.size(), false);
+    for (; step > 0; step /= 2)
+    {
+      for (size_t i=0; i<nodes.size(); i+=step)
+      {
+        if (! taken[i])
+        {
+          taken[i] = true;
+          interleaved.push_back(nodes[i]);
+        }
+      }
+    }
+    nodes.swap(interleaved);
+  }
+
+  BatchQueue queue(nodes, batch_size);
+  boost::thread_group threads;
+  for (size_t i=0; i<num_threads; ++i)
+  {
+    threads.create_thread(
+        boost::bind(work, boost::ref(queue), boost::ref(visitor)));
+  }
+  threads.join_all();
+} // function executeBatched
+
+/* ----- END OF batch.cc  ----- */
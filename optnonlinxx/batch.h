@@ -0,0 +1,235 @@
+/*! \file batch.h
+ * \brief Declaration of the batched evaluation of parameter space nodes.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Declaration of the batched evaluation of parameter space nodes.
+ * Instead of sending a visitor through the parameter space node by node the
+ * nodes are collected and handed over to the visitor in blocks. Visitors
+ * then are able to evaluate all nodes of a block while the time series are
+ * streamed through the cache only once.
+ *
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  Pruning of nodes and interleaved node order.
+ * 16/10/2026  V0.3  Provide TopKBatchVisitor.
+ * 16/10/2026  V0.4  Provide SinkBatchVisitor.
+ *
+ * ============================================================================
+ */
+
+#include <cstddef>
+#include <vector>
+#include <optimizexx/node.h>
+#include <optimizexx/globalalgorithms/gridsearch.h>
+#include "types.h"
+#include "prune.h"
+#include "../commonxx/topk.h"
+#include "../commonxx/sink.h"
+
+#ifndef _OPTNONLIN_BATCH_H_
+#define _OPTNONLIN_BATCH_H_
+
+namespace opt = optimize;
+
+//! node type of the optnonlin parameter space
+typedef opt::Node<TcoordType, TresultType> TnodeType;
+//! list of the best nodes of the optnonlin parameter space
+typedef TopKResults<TcoordType, TresultType> TtopKType;
+//! result sink of the optnonlin parameter space
+typedef ResultSink<TcoordType, TresultType> TsinkType;
+
+/*!
+ * interface of a visitor which is able to evaluate a block of parameter space
+ * nodes at once
+ *
+ * Visitors implement this interface additionally to
+ * opt::ParameterSpaceVisitor, so both the per-node and the batched path are
+ * available.
+ */
+class BatchVisitor
+{
+  public:
+    //! destructor
+    virtual ~BatchVisitor() { }
+    /*!
+     * evaluate a block of nodes
+     *
+     * \param nodes pointer to the first node of the block
+     * \param count number of nodes in the block
+     */
+    virtual void visitBatch(TnodeType* const* nodes, int count) = 0;
+    /*!
+     * abort nodes which cannot be among the best nodes
+     *
+     * \param threshold shared bound or 0 to compute all nodes completely
+     */
+    virtual void setPruning(TopKThreshold* threshold) = 0;
+
+}; // class BatchVisitor
+
+/*!
+ * batch visitor offering the nodes evaluated by another batch visitor to a
+ * list of the best nodes
+ */
+class TopKBatchVisitor : public BatchVisitor
+{
+  public:
+    /*!
+     * constructor
+     *
+     * \param visitor visitor computing the results
+     * \param results list the nodes are offered to
+     */
+    TopKBatchVisitor(BatchVisitor& visitor, TtopKType& results) :
+      Mvisitor(visitor), Mresults(results)
+    { }
+    //! evaluate a block of nodes
+    virtual void visitBatch(TnodeType* const* nodes, int count);
+    //! abort nodes which cannot be among the best nodes
+    virtual void setPruning(TopKThreshold* threshold)
+    {
+      Mvisitor.setPruning(threshold);
+    }
+
+  private:
+    //! visitor computing the results
+    BatchVisitor& Mvisitor;
+    //! list of the best nodes
+    TtopKType& Mresults;
+
+}; // class TopKBatchVisitor
+
+/*!
+ * batch visitor pushing the nodes evaluated by another batch visitor to a
+ * result sink
+ */
+class SinkBatchVisitor : public BatchVisitor
+{
+  public:
+    /*!
+     * constructor
+     *
+     * \param visitor visitor computing the results
+     * \param sink sink the nodes are pushed to
+     */
+    SinkBatchVisitor(BatchVisitor& visitor, TsinkType& sink) :
+      Mvisitor(visitor), Msink(sink)
+    { }
+    //! evaluate a block of nodes
+    virtual void visitBatch(TnodeType* const* nodes, int count);
+    //! abort nodes which cannot be among the best nodes
+    virtual void setPruning(TopKThreshold* threshold)
+    {
+      Mvisitor.setPruning(threshold);
+    }
+
+  private:
+    //! visitor computing the results
+    BatchVisitor& Mvisitor;
+    //! result sink
+    TsinkType& Msink;
+
+}; // class SinkBatchVisitor
+
+/*!
+ * batch visitor evaluating the nodes of a block one by one by a visitor
+ * without batch interface
+ */
+class NodeBatchVisitor : public BatchVisitor
+{
+  public:
+    /*!
+     * constructor
+     *
+     * \param visitor visitor computing the results
+     */
+    NodeBatchVisitor(
+        opt::ParameterSpaceVisitor<TcoordType, TresultType>& visitor) :
+      Mvisitor(visitor)
+    { }
+    //! evaluate a block of nodes
+    virtual void visitBatch(TnodeType* const* nodes, int count)
+    {
+      for (int i=0; i<count; ++i) { Mvisitor(nodes[i]); }
+    }
+    //! pruning is not supported
+    virtual void setPruning(TopKThreshold*) { }
+
+  private:
+    //! visitor computing the results
+    opt::ParameterSpaceVisitor<TcoordType, TresultType>& Mvisitor;
+
+}; // class NodeBatchVisitor
+
+/*!
+ * evaluate a list of nodes in batches
+ *
+ * Batches of consecutive nodes of the list are distributed dynamically to
+ * the threads. If \a interleave is true the nodes are visited in
+ * bit-reversed order instead: first every \f$2^m\f$-th node, then the
+ * nodes in between and so on. Thus the whole list is sampled coarsely
+ * first which finds good nodes early if nodes are pruned.
+ *
+ * \param nodes nodes to evaluate
+ * \param visitor visitor evaluating the batches
+ * \param batch_size maximum number of nodes in a batch
+ * \param num_threads number of threads to start
+ * \param interleave flag if the nodes are visited in interleaved order
+ */
+void executeBatched(std::vector<TnodeType*> nodes, BatchVisitor& visitor,
+    size_t batch_size, size_t num_threads, bool interleave=false);
+
+//! nodes of the parameter space of a global algorithm in forward order
+std::vector<TnodeType*> collectNodes(
+    opt::GlobalAlgorithm<TcoordType, TresultType>& algo);
+
+/*!
+ * evaluate all nodes of the parameter space of a global algorithm in
+ * batches
+ *
+ * The nodes are collected in the order of a forward node iterator. Thus
+ * consecutive nodes of a batch usually differ in the fastest varying
+ * coordinate only. Batches are distributed dynamically to the threads.
+ *
+ * If \a interleave is true the nodes are visited in bit-reversed order
+ * instead: first every \f$2^m\f$-th node, then the nodes in between and so
+ * on. Thus the whole parameter space is sampled coarsely first which finds
+ * good nodes early if nodes are pruned.
+ *
+ * \param algo global algorithm with a constructed parameter space
+ * \param visitor visitor evaluating the batches
+ * \param batch_size maximum number of nodes in a batch
+ * \param num_threads number of threads to start
+ * \param interleave flag if the nodes are visited in interleaved order
+ */
+void executeBatched(opt::GlobalAlgorithm<TcoordType, TresultType>& algo,
+    BatchVisitor& visitor, size_t batch_size, size_t num_threads,
+    bool interleave=false);
+
+#endif // include guard
+
+/* ----- END OF batch.h  ----- */
@@ -0,0 +1,283 @@
+/*! \file bnb.cc
+ * \brief Implementation of the branch and bound search of the grid minimum.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Implementation of the branch and bound search of the grid
+ * minimum.
+ *
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <string>
+#include <cmath>
+#include <queue>
+#include <limits>
+#include <algorithm>
+#include <boost/thread.hpp>
+#include "bnb.h"
+#include "model.h"
+
+namespace
+{
+  //! number of sweeps of the projected coordinate descent
+  int const sweeps = 16;
+  // pi constant
+  double const pi = 4.*atan(1.);
+
+  //! box waiting for evaluation
+  template <typename Tbox>
+  struct QueueItem
+  {
+    //! lower bound of the sum of the squared residual
+    double bound;
+    //! box
+    Tbox box;
+    //! smallest bound on top of a priority queue
+    bool operator<(QueueItem const& item) const { return bound > item.bound; }
+  }; // struct QueueItem
+} // namespace (unnamed)
+
+/* -------------------------------------------------------------------------- */
+BranchAndBound::BranchAndBound(GramMatrix const& gram,
+    std::vector<std::shared_ptr<TparameterType>> const& params,
+    CoordinateMap const& coordinates, int terms, double tolerance,
+    size_t num_threads) : Mgram(gram), Mh(coordinates["h"]),
+  MT0(coordinates["T0"]), Mtolerance(tolerance),
+  MnumThreads(std::max(num_threads, size_t(1)))
+{
+  if (Mgram.size() != terms+4)
+  {
+    throw std::string("Gram matrix does not match the model.");
+  }
+  if (0 > Mtolerance || 1 <= Mtolerance)
+  {
+    throw std::string("Illegal tolerance of the branch and bound search.");
+  }
+  for (auto cit(params.cbegin()); cit != params.cend(); ++cit)
+  {
+    Maxes.push_back(samplingPoints(**cit));
+    if (Maxes.back().empty())
+    {
+      throw std::string("Empty axis of parameter '"+(*cit)->getId()+"'.");
+    }
+  }
+  if (0 >= Maxes[MT0].front())
+  {
+    throw std::string("Eigenperiod must be positive.");
+  }
+  for (int i=0; i<terms; ++i)
+  {
+    Mc.push_back(coordinates[model::coefficientId(i)]);
+  }
+} // BranchAndBound::BranchAndBound
+
+/* -------------------------------------------------------------------------- */
+double BranchAndBound::residual(std::vector<size_t> const& index) const
+{
+  int const k = Mgram.size();
+  std::vector<double> c(k);
+  double const h = Maxes[Mh][index[Mh]];
+  double const T0 = Maxes[MT0][index[MT0]];
+  c[0] = 1.;
+  c[1] = ((2*pi)/T0)*h;
+  c[2] = (4.*pow(pi, 2.))/T0;
+  for (size_t i=0; i<Mc.size(); ++i) { c[3+i] = Maxes[Mc[i]][index[Mc[i]]]; }
+  c[k-1] = -1.;
+  return Mgram.quadraticForm(&c[0]);
+} // function BranchAndBound::residual
+
+/* -------------------------------------------------------------------------- */
+double BranchAndBound::bound(Tbox const& box) const
+{
+  int const k = Mgram.size();
+  // intervals of the coefficients
+  std::vector<double> lo(k), hi(k);
+  lo[0] = hi[0] = 1.;
+  lo[k-1] = hi[k-1] = -1.;
+  double const h[2] = { Maxes[Mh][box[Mh].first], Maxes[Mh][box[Mh].second] };
+  double const T0[2] =
+    { Maxes[MT0][box[MT0].first], Maxes[MT0][box[MT0].second] };
+  lo[1] = std::numeric_limits<double>::infinity();
+  hi[1] = -lo[1];
+  for (int i=0; i<2; ++i)
+  {
+    for (int j=0; j<2; ++j)
+    {
+      double const a1 = ((2*pi)/T0[j])*h[i];
+      lo[1] = std::min(lo[1], a1);
+      hi[1] = std::max(hi[1], a1);
+    }
+  }
+  lo[2] = (4.*pow(pi, 2.))/T0[1];
+  hi[2] = (4.*pow(pi, 2.))/T0[0];
+  for (size_t i=0; i<Mc.size(); ++i)
+  {
+    lo[3+i] = Maxes[Mc[i]][box[Mc[i]].first];
+    hi[3+i] = Maxes[Mc[i]][box[Mc[i]].second];
+  }
+
+  // approximate minimizer by projected coordinate descent
+  std::vector<double> c(k);
+  for (int j=0; j<k; ++j) { c[j] = 0.5*(lo[j]+hi[j]); }
+  for (int sweep=0; sweep<sweeps; ++sweep)
+  {
+    for (int j=1; j<k-1; ++j)
+    {
+      if (0 >= Mgram(j, j)) { continue; }
+      double s = 0;
+      for (int l=0; l<k; ++l) { if (l != j) { s += Mgram(j, l)*c[l]; } }
+      c[j] = std::min(hi[j], std::max(lo[j], -s/Mgram(j, j)));
+    }
+  }
+
+  // first order bound of the convex quadratic form
+  double retval = Mgram.quadraticForm(&c[0]);
+  for (int j=1; j<k-1; ++j)
+  {
+    double g = 0;
+    for (int l=0; l<k; ++l) { g += 2.*Mgram(j, l)*c[l]; }
+    retval += g > 0 ? g*(lo[j]-c[j]) : g*(hi[j]-c[j]);
+  }
+  return std::max(0., retval);
+} // function BranchAndBound::bound
+
+/* -------------------------------------------------------------------------- */
+BnbResult BranchAndBound::search() const
+{
+  typedef QueueItem<Tbox> Titem;
+  std::priority_queue<Titem> queue;
+  boost::mutex mutex;
+  boost::condition_variable changed;
+  size_t active = 0;
+  double best = std::numeric_limits<double>::infinity();
+  double discarded = std::numeric_limits<double>::infinity();
+  std::vector<size_t> best_index;
+  size_t boxes = 0;
+  size_t pruned = 0;
+  double const factor = (1.-Mtolerance)*(1.-Mtolerance);
+
+  Titem root;
+  for (auto cit(Maxes.cbegin()); cit != Maxes.cend(); ++cit)
+  {
+    root.box.push_back(std::make_pair(size_t(0), cit->size()-1));
+  }
+  root.bound = bound(root.box);
+  queue.push(root);
+
+  auto work = [&]()
+  {
+    boost::mutex::scoped_lock lock(mutex);
+    while (true)
+    {
+      while (queue.empty() && 0 < active) { changed.wait(lock); }
+      if (queue.empty()) { break; }
+      Titem item(queue.top());
+      queue.pop();
+      if (item.bound >= factor*best)
+      {
+        ++pruned;
+        discarded = std::min(discarded, item.bound);
+        continue;
+      }
+      ++active;
+      ++boxes;
+      lock.unlock();
+
+      // evaluate the center node
+      std::vector<size_t> center;
+      size_t split = 0;
+      size_t width = 0;
+      for (size_t i=0; i<item.box.size(); ++i)
+      {
+        center.push_back((item.box[i].first+item.box[i].second)/2);
+        if (item.box[i].second-item.box[i].first > width)
+        {
+          width = item.box[i].second-item.box[i].first;
+          split = i;
+        }
+      }
+      double const value = residual(center);
+
+      // split the longest axis
+      std::vector<Titem> children;
+      if (0 < width)
+      {
+        Titem child(item);
+        child.box[split].second = center[split];
+        child.bound = bound(child.box);
+        children.push_back(child);
+        child.box[split] = std::make_pair(center[split]+1,
+            item.box[split].second);
+        child.bound = bound(child.box);
+        children.push_back(child);
+      }
+
+      lock.lock();
+      if (value < best)
+      {
+        best = value;
+        best_index = center;
+      }
+      for (auto cit(children.cbegin()); cit != children.cend(); ++cit)
+      {
+        if (cit->bound >= factor*best)
+        {
+          ++pruned;
+          discarded = std::min(discarded, cit->bound);
+        } else
+        {
+          queue.push(*cit);
+        }
+      }
+      --active;
+      changed.notify_all();
+    }
+  };
+
+  boost::thread_group threads;
+  for (size_t i=0; i<MnumThreads; ++i) { threads.create_thread(work); }
+  threads.join_all();
+
+  int const k = Mgram.size();
+  double const norm = Mgram(k-1, k-1);
+  BnbResult retval;
+  for (size_t i=0; i<best_index.size(); ++i)
+  {
+    retval.coordinates.push_back(Maxes[i][best_index[i]]);
+  }
+  retval.rms = sqrt(best/norm);
+  retval.bound = sqrt(std::min(best, discarded)/norm);
+  retval.boxes = boxes;
+  retval.pruned = pruned;
+  return retval;
+} // function BranchAndBound::search
+
+/* ----- END OF bnb.cc  ----- */
@@ -0,0 +1,140 @@
+/*! \file bnb.h
+ * \brief Declaration of the branch and bound search of the grid minimum.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Declaration of the branch and bound search of the grid minimum.
+ * Instead of evaluating all nodes of the grid, boxes of nodes are split
+ * recursively and discarded as soon as a lower bound of the RMS misfit of
+ * their nodes exceeds the best misfit found so far.
+ *
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <vector>
+#include <memory>
+#include "types.h"
+#include "gram.h"
+#include "axis.h"
+#include "coordinates.h"
+
+#ifndef _OPTNONLIN_BNB_H_
+#define _OPTNONLIN_BNB_H_
+
+//! result of the branch and bound search
+struct BnbResult
+{
+  //! coordinates of the best node
+  std::vector<TcoordType> coordinates;
+  //! RMS misfit of the best node
+  double rms;
+  //! certified lower bound of the RMS misfit of all nodes
+  double bound;
+  //! number of boxes evaluated
+  size_t boxes;
+  //! number of boxes discarded by their lower bound
+  size_t pruned;
+}; // struct BnbResult
+
+/*!
+ * branch and bound search of the node with the smallest RMS misfit
+ *
+ * A box is a set of consecutive sampling points on each axis. The model
+ * coefficients
+ * \f[
+ *    a_1=\frac{2\pi}{T_0}h,\quad a_2=\frac{4\pi^2}{T_0},\quad c_i
+ * \f]
+ * of the nodes of a box lie within intervals derived from the box. The
+ * sum of the squared residual \f$c^TGc\f$ is convex in the coefficients.
+ * Its minimum over the intervals is approximated by projected coordinate
+ * descent; at the approximate minimizer \f$\hat{c}\f$
+ * \f[
+ *    c^TGc \ge \hat{c}^TG\hat{c}+\min_{c}2(G\hat{c})^T(c-\hat{c})
+ * \f]
+ * holds for all \f$c\f$ of the intervals, which is a lower bound of the
+ * misfit of all nodes of the box no matter how accurate \f$\hat{c}\f$ is.
+ *
+ * Boxes are processed best bound first from a queue shared by all
+ * threads. The center node of each box is evaluated to improve the best
+ * misfit. Boxes are split at the middle of their longest axis until they
+ * hold a single node. Thus the result is the minimum of the grid, i.e.
+ * the minimizer to the resolution of the axes.
+ */
+class BranchAndBound
+{
+  public:
+    /*!
+     * constructor
+     *
+     * \param gram Gram matrix of the regressors
+     * \param params unknown parameters in coordinate order
+     * \param coordinates coordinate indices of the unknown parameters
+     * \param terms number of nonlinear terms of the model
+     * \param tolerance boxes are discarded if their bound exceeds the best
+     * RMS misfit times (1-tolerance)
+     * \param num_threads number of threads
+     */
+    BranchAndBound(GramMatrix const& gram,
+        std::vector<std::shared_ptr<TparameterType>> const& params,
+        CoordinateMap const& coordinates, int terms, double tolerance,
+        size_t num_threads);
+
+    //! perform the search
+    BnbResult search() const;
+
+  private:
+    //! first and last index of the sampling points of each axis
+    typedef std::vector<std::pair<size_t, size_t>> Tbox;
+
+    //! sum of the squared residual of a node
+    double residual(std::vector<size_t> const& index) const;
+    //! lower bound of the sum of the squared residual within a box
+    double bound(Tbox const& box) const;
+
+    //! Gram matrix of the regressors
+    GramMatrix const& Mgram;
+    //! sampling points of each axis
+    std::vector<std::vector<TcoordType>> Maxes;
+    //! coordinate index of the damping
+    int Mh;
+    //! coordinate index of the eigenperiod
+    int MT0;
+    //! coordinate indices of the coefficients of the nonlinear terms
+    std::vector<int> Mc;
+    //! relative tolerance of the RMS misfit
+    double Mtolerance;
+    //! number of threads
+    size_t MnumThreads;
+
+}; // class BranchAndBound
+
+#endif // include guard
+
+/* ----- END OF bnb.h  ----- */
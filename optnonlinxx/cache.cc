@@ -0,0 +1,299 @@
+/*! \file cache.cc
+ * \brief Implementation of the on-disk cache of prepared regressors.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Implementation of the on-disk cache of prepared regressors.
+ *
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  Series are stored aligned and padded like the columns of
+ *                   a FeatureMatrix.
+ *
+ * ============================================================================
+ */
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <stdint.h>
+#include <unistd.h>
+#include "cache.h"
+#include "kernel.h"
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+  //! file suffix of cache entries
+  std::string const suffix(".feat");
+
+  /*!
+   * header of a cache entry; the samples follow directly
+   *
+   * The header takes a multiple of FeatureMatrix::alignment bytes, so the
+   * mapped series start at aligned addresses.
+   */
+  struct Header
+  {
+    //! identification of the file format
+    char magic[16];
+    //! number of samples of each series
+    uint64_t n;
+    //! number of series
+    uint64_t count;
+    //! distance of consecutive series in samples
+    uint64_t stride;
+    //! number of regressors of the Gram matrix (0: none)
+    uint64_t k;
+    //! size of the extended precision type of the Gram matrix
+    uint64_t ldsize;
+    //! padding to keep the samples aligned
+    char reserved[8];
+  }; // struct Header
+
+  //! identification of the file format
+  char const magic[16] = "OPTNONLIN-FC-02";
+
+  //! 64 bit FNV-1a hash
+  void hash(uint64_t& h, void const* data, size_t size)
+  {
+    unsigned char const* c = static_cast<unsigned char const*>(data);
+    for (size_t i=0; i<size; ++i)
+    {
+      h ^= c[i];
+      h *= 1099511628211ULL;
+    }
+  } // function hash
+} // namespace (unnamed)
+
+/* -------------------------------------------------------------------------- */
+CacheEntry::CacheEntry(std::string const& filename) : Mfile(filename),
+  Mn(0), Mstride(0), Mcount(0), Mk(0)
+{
+  if (Mfile.size() < sizeof(Header))
+  {
+    throw std::string("Illegal cache entry '"+filename+"'.");
+  }
+  Header header;
+  memcpy(&header, Mfile.data(), sizeof(Header));
+  Mn = header.n;
+  Mstride = header.stride;
+  Mcount = header.count;
+  Mk = header.k;
+  if (0 != memcmp(header.magic, magic, sizeof(magic)) ||
+      sizeof(long double) != header.ldsize || 0 == Mn ||
+      FeatureMatrix::alignedStride(Mn) != Mstride ||
+      Mfile.size() != sizeof(Header)+Mcount*Mstride*sizeof(double)+
+      Mk*Mk*sizeof(long double))
+  {
+    throw std::string("Illegal cache entry '"+filename+"'.");
+  }
+} // CacheEntry::CacheEntry
+
+/* -------------------------------------------------------------------------- */
+double const* CacheEntry::column(size_t i) const
+{
+  if (i >= Mcount) { throw std::string("Illegal series of cache entry."); }
+  return reinterpret_cast<double const*>(
+        Mfile.data()+sizeof(Header))+i*Mstride;
+} // function CacheEntry::column
+
+/* -------------------------------------------------------------------------- */
+datrw::Tdseries CacheEntry::series(size_t i) const
+{
+  return viewSeries(column(i), Mn);
+} // function CacheEntry::series
+
+/* -------------------------------------------------------------------------- */
+FeatureMatrix* CacheEntry::matrix() const
+{
+  return new FeatureMatrix(column(0), Mn, Mcount, Mstride);
+} // function CacheEntry::matrix
+
+/* -------------------------------------------------------------------------- */
+GramMatrix CacheEntry::gram() const
+{
+  std::vector<long double> data(Mk*Mk);
+  memcpy(&data[0],
+      Mfile.data()+sizeof(Header)+Mcount*Mstride*sizeof(double),
+      data.size()*sizeof(long double));
+  return GramMatrix(Mk, data);
+} // function CacheEntry::gram
+
+/* -------------------------------------------------------------------------- */
+FeatureCache::FeatureCache(fs::path const& directory, size_t limit) :
+  Mdirectory(directory), Mlimit(limit)
+{
+  fs::create_directories(Mdirectory);
+} // FeatureCache::FeatureCache
+
+/* -------------------------------------------------------------------------- */
+std::string FeatureCache::key(
+    std::vector<datrw::Tdseries const*> const& inputs, double dt,
+    std::string const& settings)
+{
+  uint64_t h = 14695981039346656037ULL;
+  for (auto cit(inputs.cbegin()); cit != inputs.cend(); ++cit)
+  {
+    uint64_t const n = (*cit)->size();
+    hash(h, &n, sizeof(n));
+    hash(h, kernel::samples(**cit), n*sizeof(double));
+  }
+  hash(h, &dt, sizeof(dt));
+  hash(h, settings.data(), settings.size());
+  std::ostringstream oss;
+  oss << std::hex << std::setw(16) << std::setfill('0') << h;
+  return oss.str();
+} // function FeatureCache::key
+
+/* -------------------------------------------------------------------------- */
+fs::path FeatureCache::path(std::string const& key) const
+{
+  fs::path retval(Mdirectory);
+  retval /= key+suffix;
+  return retval;
+} // function FeatureCache::path
+
+/* -------------------------------------------------------------------------- */
+CacheEntry* FeatureCache::load(std::string const& key) const
+{
+  fs::path const entry(path(key));
+  if (! fs::exists(entry)) { return 0; }
+  try
+  {
+    CacheEntry* retval = new CacheEntry(entry.string());
+    // the modification time orders the entries by their last use; failing to
+    // update it only affects the order of removal
+    boost::system::error_code ec;
+    fs::last_write_time(entry, std::time(0), ec);
+    return retval;
+  }
+  catch (std::string)
+  {
+    // a damaged entry is a miss and will be replaced
+    return 0;
+  }
+} // function FeatureCache::load
+
+/* -------------------------------------------------------------------------- */
+void FeatureCache::store(std::string const& key,
+    std::vector<datrw::Tdseries const*> const& series,
+    GramMatrix const* gram) const
+{
+  Header header;
+  memset(&header, 0, sizeof(Header));
+  memcpy(header.magic, magic, sizeof(magic));
+  header.n = series.empty() ? 0 : series.front()->size();
+  header.count = series.size();
+  header.stride = FeatureMatrix::alignedStride(header.n);
+  header.k = gram ? gram->size() : 0;
+  header.ldsize = sizeof(long double);
+
+  // write to a temporary file first so concurrent runs never map a partial
+  // entry
+  std::ostringstream tmpname;
+  tmpname << path(key).string() << ".tmp" << getpid();
+  fs::path const tmp(tmpname.str());
+  try
+  {
+    std::ofstream ofs(tmp.string().c_str(),
+        std::ios::out | std::ios::binary);
+    // zeros padding each series up to the stride
+    std::vector<double> const padding(header.stride-header.n+1, 0.);
+    ofs.write(reinterpret_cast<char const*>(&header), sizeof(Header));
+    for (auto cit(series.cbegin()); cit != series.cend(); ++cit)
+    {
+      if (uint64_t((*cit)->size()) != header.n)
+      {
+        throw std::string("Cached series differ in size.");
+      }
+      ofs.write(reinterpret_cast<char const*>(kernel::samples(**cit)),
+          header.n*sizeof(double));
+      ofs.write(reinterpret_cast<char const*>(&padding[0]),
+          (header.stride-header.n)*sizeof(double));
+    }
+    if (gram)
+    {
+      ofs.write(reinterpret_cast<char const*>(&gram->data()[0]),
+          gram->data().size()*sizeof(long double));
+    }
+    if (! ofs) { throw std::string("Cannot write cache entry."); }
+    ofs.close();
+    fs::rename(tmp, path(key));
+  }
+  catch (...)
+  {
+    // never leave partial entries behind
+    boost::system::error_code ec;
+    fs::remove(tmp, ec);
+    throw;
+  }
+  prune();
+} // function FeatureCache::store
+
+/* -------------------------------------------------------------------------- */
+void FeatureCache::prune() const
+{
+  struct Entry
+  {
+    std::time_t time;
+    uintmax_t size;
+    fs::path path;
+    bool operator<(Entry const& e) const { return time < e.time; }
+  };
+  std::vector<Entry> entries;
+  uintmax_t total = 0;
+  for (fs::directory_iterator it(Mdirectory); it != fs::directory_iterator();
+      ++it)
+  {
+    std::string const name(it->path().string());
+    if (name.size() <= suffix.size() ||
+        0 != name.compare(name.size()-suffix.size(), suffix.size(), suffix))
+    {
+      continue;
+    }
+    Entry entry;
+    entry.time = fs::last_write_time(it->path());
+    entry.size = fs::file_size(it->path());
+    entry.path = it->path();
+    entries.push_back(entry);
+    total += entry.size;
+  }
+  std::sort(entries.begin(), entries.end());
+  for (auto cit(entries.cbegin()); cit != entries.cend() && total > Mlimit;
+      ++cit)
+  {
+    fs::remove(cit->path);
+    total -= cit->size;
+  }
+} // function FeatureCache::prune
+
+/* ----- END OF cache.cc  ----- */
@@ -0,0 +1,167 @@
+/*! \file cache.h
+ * \brief Declaration of the on-disk cache of prepared regressors.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Declaration of the on-disk cache of prepared regressors. The
+ * derivatives and the regressors of the nonlinear terms of a recording as
+ * well as the Gram matrix are stored in a cache directory. Subsequent runs
+ * on the same recording map them into memory and use the mapped samples in
+ * place instead of computing them again. The series are stored in the
+ * layout of a FeatureMatrix. Entries are keyed by a hash of the samples of the input series,
+ * the sampling interval and the preparation settings. The least recently
+ * used entries are removed if the cache exceeds its size limit.
+ *
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  Series are stored aligned and padded like the columns of
+ *                   a FeatureMatrix.
+ *
+ * ============================================================================
+ */
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <boost/filesystem.hpp>
+#include <datrwxx/types.h>
+#include "mapped.h"
+#include "gram.h"
+#include "featurematrix.h"
+
+#ifndef _OPTNONLIN_CACHE_H_
+#define _OPTNONLIN_CACHE_H_
+
+/*!
+ * cache entry mapped into memory
+ *
+ * The series returned refer to the mapped samples and must not be used
+ * after the entry was destroyed.
+ */
+class CacheEntry
+{
+  public:
+    /*!
+     * constructor
+     *
+     * \param filename path of the entry
+     */
+    CacheEntry(std::string const& filename);
+    //! number of series
+    size_t count() const { return Mcount; }
+    //! number of samples of each series
+    size_t size() const { return Mn; }
+    //! distance of consecutive series in samples
+    size_t stride() const { return Mstride; }
+    //! samples of series \a i
+    double const* column(size_t i) const;
+    //! read-only view of series \a i
+    datrw::Tdseries series(size_t i) const;
+    /*!
+     * read-only view of all series
+     *
+     * The matrix refers to the mapped samples and must not be used after the
+     * entry was destroyed.
+     */
+    FeatureMatrix* matrix() const;
+    //! flag if the entry holds a Gram matrix
+    bool hasGram() const { return 0 < Mk; }
+    //! stored Gram matrix
+    GramMatrix gram() const;
+
+  private:
+    //! mapped file
+    MappedFile Mfile;
+    //! number of samples of each series
+    size_t Mn;
+    //! distance of consecutive series in samples
+    size_t Mstride;
+    //! number of series
+    size_t Mcount;
+    //! number of regressors of the Gram matrix (0: none)
+    size_t Mk;
+
+}; // class CacheEntry
+
+/*!
+ * directory of cache entries
+ */
+class FeatureCache
+{
+  public:
+    /*!
+     * constructor
+     *
+     * \param directory cache directory; created if not existing
+     * \param limit maximum size of all entries in bytes
+     */
+    FeatureCache(boost::filesystem::path const& directory, size_t limit);
+    /*!
+     * key of an entry
+     *
+     * \param inputs input series the entry is derived from
+     * \param dt sampling interval
+     * \param settings description of the preparation settings
+     */
+    static std::string key(std::vector<datrw::Tdseries const*> const& inputs,
+        double dt, std::string const& settings);
+    /*!
+     * look up an entry and mark it as used
+     *
+     * \return entry (to be deleted by the caller) or 0 if missing
+     */
+    CacheEntry* load(std::string const& key) const;
+    /*!
+     * store an entry and remove least recently used entries
+     *
+     * On failure the temporary file is removed and the exception is passed
+     * on; the cache is left as before.
+     *
+     * \param key key of the entry
+     * \param series series to store (all of the same size)
+     * \param gram Gram matrix to store or 0
+     */
+    void store(std::string const& key,
+        std::vector<datrw::Tdseries const*> const& series,
+        GramMatrix const* gram) const;
+
+  private:
+    //! path of an entry
+    boost::filesystem::path path(std::string const& key) const;
+    //! remove least recently used entries exceeding the size limit
+    void prune() const;
+
+    //! cache directory
+    boost::filesystem::path Mdirectory;
+    //! size limit in bytes
+    size_t Mlimit;
+
+}; // class FeatureCache
+
+#endif // include guard
+
+/* ----- END OF cache.h  ----- */
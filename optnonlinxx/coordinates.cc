@@ -0,0 +1,70 @@
+/*! \file coordinates.cc
+ * \brief Implementation of the mapping of parameter ids to node coordinates.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Implementation of the mapping of parameter ids to node
+ * coordinates.
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <algorithm>
+#include "coordinates.h"
+
+/* -------------------------------------------------------------------------- */
+CoordinateMap::CoordinateMap(std::vector<std::string> const& ids) : Mids(ids)
+{
+  for (auto cit(Mids.cbegin()); cit != Mids.cend(); ++cit)
+  {
+    if (std::count(Mids.cbegin(), Mids.cend(), *cit) != 1)
+    {
+      throw std::string("Parameter '"+*cit+"' specified more than once.");
+    }
+  }
+} // constructor CoordinateMap
+
+/* -------------------------------------------------------------------------- */
+bool CoordinateMap::contains(std::string const& id) const
+{
+  return std::find(Mids.cbegin(), Mids.cend(), id) != Mids.cend();
+} // function CoordinateMap::contains
+
+/* -------------------------------------------------------------------------- */
+int CoordinateMap::operator[](std::string const& id) const
+{
+  auto cit = std::find(Mids.cbegin(), Mids.cend(), id);
+  if (cit == Mids.cend())
+  {
+    throw std::string("Missing parameter '"+id+"'.");
+  }
+  return cit - Mids.cbegin();
+} // function CoordinateMap::operator[]
+
+/* ----- END OF coordinates.cc  ----- */
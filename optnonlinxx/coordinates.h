@@ -0,0 +1,81 @@
+/*! \file coordinates.h
+ * \brief Declaration of the mapping of parameter ids to node coordinates.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Declaration of the mapping of parameter ids to node coordinates.
+ * The coordinates of a parameter space node are ordered like the parameters
+ * were added to the global algorithm. Visitors look up the coordinate index
+ * of a parameter by its id once instead of relying on a fixed order.
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <string>
+#include <vector>
+
+#ifndef _OPTNONLIN_COORDINATES_H_
+#define _OPTNONLIN_COORDINATES_H_
+
+/*!
+ * maps the ids of the unknown parameters to the indices of the node
+ * coordinates
+ */
+class CoordinateMap
+{
+  public:
+    /*!
+     * constructor
+     *
+     * \param ids parameter ids in the order the parameters were added to the
+     * global algorithm
+     */
+    CoordinateMap(std::vector<std::string> const& ids);
+    //! number of coordinates
+    int size() const { return Mids.size(); }
+    //! check if a parameter with id \a id is available
+    bool contains(std::string const& id) const;
+    /*!
+     * coordinate index of a parameter
+     *
+     * Throws if there is no parameter with id \a id.
+     */
+    int operator[](std::string const& id) const;
+    //! parameter id of coordinate \a index
+    std::string const& id(int index) const { return Mids.at(index); }
+
+  private:
+    //! parameter ids in coordinate order
+    std::vector<std::string> Mids;
+
+}; // class CoordinateMap
+
+#endif // include guard
+
+/* ----- END OF coordinates.h  ----- */
@@ -0,0 +1,188 @@
+/*! \file derivative.cc
+ * \brief Implementation of selectable derivative operators.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Implementation of selectable derivative operators.
+ *
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include "derivative.h"
+
+namespace
+{
+  /*!
+   * Savitzky-Golay coefficients of the derivative of order \a d
+   *
+   * The coefficients are the row \a d of \f$(A^TA)^{-1}A^T\f$ times
+   * \f$d!\f$ where \f$A_{ik}=i^k\f$ for \f$i=-m,\ldots,m\f$ and
+   * \f$k=0,\ldots,p\f$.
+   */
+  std::vector<double> savitzkyGolay(int m, int p, int d)
+  {
+    int const q = p+1;
+    // normal equations augmented with the unit vector e_d
+    std::vector<long double> a(q*(q+1), 0.L);
+    for (int k=0; k<q; ++k)
+    {
+      for (int l=0; l<q; ++l)
+      {
+        for (int i=-m; i<=m; ++i) { a[k*(q+1)+l] += powl(i, k+l); }
+      }
+      a[k*(q+1)+q] = (k == d) ? 1.L : 0.L;
+    }
+    // Gauss-Jordan elimination with partial pivoting
+    for (int k=0; k<q; ++k)
+    {
+      int pivot = k;
+      for (int r=k+1; r<q; ++r)
+      {
+        if (fabsl(a[r*(q+1)+k]) > fabsl(a[pivot*(q+1)+k])) { pivot = r; }
+      }
+      for (int c=0; c<=q; ++c)
+      {
+        std::swap(a[k*(q+1)+c], a[pivot*(q+1)+c]);
+      }
+      for (int r=0; r<q; ++r)
+      {
+        if (r == k) { continue; }
+        long double const f = a[r*(q+1)+k]/a[k*(q+1)+k];
+        for (int c=k; c<=q; ++c) { a[r*(q+1)+c] -= f*a[k*(q+1)+c]; }
+      }
+    }
+    // (A^TA)^{-1} is symmetric, so the solution is its row d
+    std::vector<long double> row(q);
+    for (int k=0; k<q; ++k) { row[k] = a[k*(q+1)+q]/a[k*(q+1)+k]; }
+    long double const factorial = (2 == d) ? 2.L : 1.L;
+    std::vector<double> retval;
+    for (int i=-m; i<=m; ++i)
+    {
+      long double c = 0;
+      for (int k=0; k<q; ++k) { c += row[k]*powl(i, k); }
+      retval.push_back(factorial*c);
+    }
+    return retval;
+  } // function savitzkyGolay
+
+  //! coefficients of a stencil divided by a common denominator
+  std::vector<double> stencil(std::vector<double> const& values,
+      double denominator)
+  {
+    std::vector<double> retval;
+    for (auto cit(values.cbegin()); cit != values.cend(); ++cit)
+    {
+      retval.push_back(*cit/denominator);
+    }
+    return retval;
+  } // function stencil
+} // namespace (unnamed)
+
+/* -------------------------------------------------------------------------- */
+DerivativeOperator::DerivativeOperator(std::string const& name) :
+  Mname(name), Mm(0)
+{
+  if ("central3" == name)
+  {
+    Mfirst = stencil({ -1, 0, 1 }, 2);
+    Msecond = stencil({ 1, -2, 1 }, 1);
+  } else
+  if ("central5" == name)
+  {
+    Mfirst = stencil({ 1, -8, 0, 8, -1 }, 12);
+    Msecond = stencil({ -1, 16, -30, 16, -1 }, 12);
+  } else
+  if ("central7" == name)
+  {
+    Mfirst = stencil({ -1, 9, -45, 0, 45, -9, 1 }, 60);
+    Msecond = stencil({ 2, -27, 270, -490, 270, -27, 2 }, 180);
+  } else
+  if (0 == name.compare(0, 2, "sg"))
+  {
+    char* end = 0;
+    long const window = strtol(name.c_str()+2, &end, 10);
+    long order = 4;
+    if (':' == *end) { order = strtol(end+1, &end, 10); }
+    if (*end || 5 > window || 0 == window % 2 || 2 > order ||
+        order >= window)
+    {
+      throw std::string("Illegal Savitzky-Golay derivative '"+name+"'.");
+    }
+    Mfirst = savitzkyGolay(window/2, order, 1);
+    Msecond = savitzkyGolay(window/2, order, 2);
+  } else
+  {
+    throw std::string("Unknown derivative operator '"+name+"'.");
+  }
+  Mm = Mfirst.size()/2;
+} // DerivativeOperator::DerivativeOperator
+
+/* -------------------------------------------------------------------------- */
+void DerivativeOperator::apply(datrw::Tdseries const& series, double dt,
+    datrw::Tdseries& y_dif2, datrw::Tdseries& y_dif) const
+{
+  if (series.size() != y_dif2.size() || series.size() != y_dif.size())
+  {
+    throw std::string("Inconsistant series size.");
+  }
+  if (series.size() < 2*Mm+1)
+  {
+    throw std::string("Time series too short.");
+  }
+  int const first = series.f()+Mm;
+  int const last = series.l()-Mm;
+  for (int j=first; j<=last; ++j)
+  {
+    double d1 = 0;
+    double d2 = 0;
+    for (int k=-Mm; k<=Mm; ++k)
+    {
+      d1 += Mfirst[k+Mm]*series(j+k);
+      d2 += Msecond[k+Mm]*series(j+k);
+    }
+    y_dif(j) = d1/dt;
+    y_dif2(j) = d2/(dt*dt);
+  }
+  for (int j=series.f(); j<first; ++j)
+  {
+    y_dif(j) = y_dif(first);
+    y_dif2(j) = y_dif2(first);
+  }
+  for (int j=last+1; j<=series.l(); ++j)
+  {
+    y_dif(j) = y_dif(last);
+    y_dif2(j) = y_dif2(last);
+  }
+} // function DerivativeOperator::apply
+
+/* ----- END OF derivative.cc  ----- */
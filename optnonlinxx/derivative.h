@@ -0,0 +1,103 @@
+/*! \file derivative.h
+ * \brief Declaration of selectable derivative operators.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Declaration of selectable derivative operators. The first and
+ * second derivative of a time series are computed by FIR filters: central
+ * difference stencils of 3, 5 or 7 points or Savitzky-Golay smoothing
+ * derivatives, which fit a polynomial to a window of samples by least
+ * squares and thus suppress high frequency noise.
+ *
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <string>
+#include <vector>
+#include <datrwxx/types.h>
+
+#ifndef _OPTNONLIN_DERIVATIVE_H_
+#define _OPTNONLIN_DERIVATIVE_H_
+
+/*!
+ * FIR filters computing the first and second derivative
+ *
+ * The coefficients refer to the samples \f$y_{j-m},\ldots,y_{j+m}\f$ and a
+ * unit sampling interval. Samples closer than \f$m\f$ to the ends take the
+ * derivatives of their nearest interior sample.
+ */
+class DerivativeOperator
+{
+  public:
+    /*!
+     * constructor
+     *
+     * \param name either 'central3', 'central5', 'central7' or 'sgW' resp.
+     * 'sgW:P' for Savitzky-Golay derivatives of the odd window length W
+     * and the polynomial order P (default: 4)
+     */
+    DerivativeOperator(std::string const& name="central3");
+    //! name of the operator
+    std::string const& name() const { return Mname; }
+    //! half width \f$m\f$ of the filters
+    int halfWidth() const { return Mm; }
+    //! flag if this is the 3-point central difference of util::dif()
+    bool isCentral3() const { return "central3" == Mname; }
+    //! coefficients of the first derivative
+    std::vector<double> const& first() const { return Mfirst; }
+    //! coefficients of the second derivative
+    std::vector<double> const& second() const { return Msecond; }
+    /*!
+     * compute both derivatives by straight convolution (reference
+     * implementation)
+     *
+     * \param series input data
+     * \param dt sampling interval
+     * \param y_dif2 receives the second derivative
+     * \param y_dif receives the first derivative
+     */
+    void apply(datrw::Tdseries const& series, double dt,
+        datrw::Tdseries& y_dif2, datrw::Tdseries& y_dif) const;
+
+  private:
+    //! name of the operator
+    std::string Mname;
+    //! half width
+    int Mm;
+    //! coefficients of the first derivative
+    std::vector<double> Mfirst;
+    //! coefficients of the second derivative
+    std::vector<double> Msecond;
+
+}; // class DerivativeOperator
+
+#endif // include guard
+
+/* ----- END OF derivative.h  ----- */
@@ -0,0 +1,125 @@
+/*! \file featurematrix.cc
+ * \brief Implementation of the aligned matrix of regressor time series.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Implementation of the aligned matrix of regressor time series.
+ *
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  Read-only view of external columns.
+ *
+ * ============================================================================
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <aff/series.h>
+#include "featurematrix.h"
+
+namespace
+{
+  //! size of a transparent huge page
+  size_t const hugePageSize = 2*1024*1024;
+} // namespace (unnamed)
+
+/* -------------------------------------------------------------------------- */
+FeatureMatrix::FeatureMatrix(size_t n, size_t count, bool huge_pages) :
+  Mn(n), Mcount(count), Mstride(alignedStride(n)), Mdata(0), Mowner(true)
+{
+  if (0 == n || 0 == count)
+  {
+    throw std::string("Illegal size of feature matrix.");
+  }
+  size_t bytes = Mstride*count*sizeof(double);
+  size_t align = alignment;
+  if (huge_pages)
+  {
+    align = hugePageSize;
+    bytes = (bytes+hugePageSize-1)/hugePageSize*hugePageSize;
+  }
+  void* data = 0;
+  if (0 != posix_memalign(&data, align, bytes))
+  {
+    throw std::string("Cannot allocate feature matrix.");
+  }
+#ifdef MADV_HUGEPAGE
+  // only a hint; the kernel falls back to regular pages silently
+  if (huge_pages) { madvise(data, bytes, MADV_HUGEPAGE); }
+#endif
+  Mdata = static_cast<double*>(data);
+  // zero the padding so kernels may read whole vectors at the column ends
+  for (size_t i=0; i<count; ++i)
+  {
+    std::fill(column(i)+n, column(i)+Mstride, 0.);
+  }
+  createSeries();
+} // FeatureMatrix::FeatureMatrix
+
+/* -------------------------------------------------------------------------- */
+FeatureMatrix::FeatureMatrix(double const* data, size_t n, size_t count,
+    size_t stride) : Mn(n), Mcount(count), Mstride(stride),
+  Mdata(const_cast<double*>(data)), Mowner(false)
+{
+  if (0 == n || 0 == count || stride != alignedStride(n) ||
+      0 != reinterpret_cast<uintptr_t>(data) % alignment)
+  {
+    throw std::string("Illegal layout of feature matrix.");
+  }
+  createSeries();
+} // FeatureMatrix::FeatureMatrix
+
+/* -------------------------------------------------------------------------- */
+FeatureMatrix::~FeatureMatrix()
+{
+  if (Mowner) { free(Mdata); }
+} // FeatureMatrix::~FeatureMatrix
+
+/* -------------------------------------------------------------------------- */
+void FeatureMatrix::createSeries()
+{
+  for (size_t i=0; i<Mcount; ++i)
+  {
+    // the shared heap does not take ownership of the memory
+    aff::SharedHeap<double> heap(column(i), Mn);
+    Mseries.push_back(
+        datrw::Tdseries(aff::LinearShape(0, Mn-1, 0), heap));
+    if (i >= featureColumn) { Mfeatures.push_back(Mseries.back()); }
+  }
+} // function FeatureMatrix::createSeries
+
+/* -------------------------------------------------------------------------- */
+datrw::Tdseries const& FeatureMatrix::series(size_t i) const
+{
+  if (i >= Mcount) { throw std::string("Illegal column of feature matrix."); }
+  return Mseries[i];
+} // function FeatureMatrix::series
+
+/* ----- END OF featurematrix.cc  ----- */
@@ -0,0 +1,147 @@
+/*! \file featurematrix.h
+ * \brief Declaration of the aligned matrix of regressor time series.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Declaration of the aligned matrix of regressor time series. The
+ * derivatives of the output signal and the regressors of the nonlinear terms
+ * are stored as the columns of a single contiguous block of memory. Every
+ * column starts at a 64 byte boundary, i.e. at a cache line and at the width
+ * of an AVX-512 register, so vectorized kernels may stream all columns with
+ * aligned loads. Optionally the block is backed by transparent huge pages
+ * which reduces TLB misses for long time series. A matrix may as well be a
+ * read-only view of columns mapped from the cache.
+ *
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  Read-only view of external columns.
+ *
+ * ============================================================================
+ */
+
+#include <cstddef>
+#include <vector>
+#include <datrwxx/types.h>
+
+#ifndef _OPTNONLIN_FEATUREMATRIX_H_
+#define _OPTNONLIN_FEATUREMATRIX_H_
+
+/*!
+ * owner of the regressor time series of optnonlin
+ *
+ * Column dif2Column holds the second derivative, column difColumn the first
+ * derivative of the output signal and the columns starting at
+ * featureColumn the regressors of the nonlinear terms. The series returned
+ * by series() and features() share the memory of the matrix and live as
+ * long as the matrix, so visitors may keep references to them.
+ *
+ * Every column is padded with zeros up to stride() samples.
+ */
+class FeatureMatrix
+{
+  public:
+    //! column of the second derivative
+    static size_t const dif2Column = 0;
+    //! column of the first derivative
+    static size_t const difColumn = 1;
+    //! first column of the regressors of the nonlinear terms
+    static size_t const featureColumn = 2;
+    //! alignment of the columns in bytes
+    static size_t const alignment = 64;
+
+    /*!
+     * constructor
+     *
+     * \param n number of samples of each column
+     * \param count number of columns
+     * \param huge_pages flag if the memory is backed by huge pages
+     */
+    FeatureMatrix(size_t n, size_t count, bool huge_pages=false);
+    /*!
+     * constructor of a read-only view of external columns
+     *
+     * The columns must start at a boundary of \c alignment bytes, must be
+     * padded with zeros up to \a stride samples and must outlive the
+     * matrix. They must not be modified through the matrix.
+     *
+     * \param data first sample of the first column
+     * \param n number of samples of each column
+     * \param count number of columns
+     * \param stride distance of consecutive columns in samples
+     */
+    FeatureMatrix(double const* data, size_t n, size_t count, size_t stride);
+    //! destructor
+    ~FeatureMatrix();
+    //! number of samples of each column
+    size_t size() const { return Mn; }
+    //! number of columns
+    size_t count() const { return Mcount; }
+    //! distance of consecutive columns in samples
+    size_t stride() const { return Mstride; }
+    //! distance of consecutive columns of \a n samples
+    static size_t alignedStride(size_t n)
+    {
+      size_t const per_line = alignment/sizeof(double);
+      return (n+per_line-1)/per_line*per_line;
+    }
+    //! samples of column \a i
+    double* column(size_t i) { return Mdata+i*Mstride; }
+    double const* column(size_t i) const { return Mdata+i*Mstride; }
+    //! column \a i as a time series sharing the memory of the matrix
+    datrw::Tdseries const& series(size_t i) const;
+    //! columns of the regressors of the nonlinear terms as time series
+    std::vector<datrw::Tdseries> const& features() const
+    {
+      return Mfeatures;
+    }
+
+  private:
+    FeatureMatrix(FeatureMatrix const&);
+    FeatureMatrix& operator=(FeatureMatrix const&);
+    //! create the time series of the columns
+    void createSeries();
+
+    //! number of samples of each column
+    size_t Mn;
+    //! number of columns
+    size_t Mcount;
+    //! distance of consecutive columns in samples
+    size_t Mstride;
+    //! aligned block of memory
+    double* Mdata;
+    //! flag if the block is owned by the matrix
+    bool Mowner;
+    //! all columns as time series
+    std::vector<datrw::Tdseries> Mseries;
+    //! columns of the regressors as time series
+    std::vector<datrw::Tdseries> Mfeatures;
+
+}; // class FeatureMatrix
+
+#endif // include guard
+
+/* ----- END OF featurematrix.h  ----- */
@@ -0,0 +1,155 @@
+/*! \file gram.cc
+ * \brief Implementation of the Gram matrix of the optnonlin regressors.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Implementation of the Gram matrix of the optnonlin regressors.
+ *
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  Minimization with respect to selected coefficients.
+ * 16/10/2026  V0.3  Construction from stored inner products.
+ *
+ * ============================================================================
+ */
+
+#include <string>
+#include <cmath>
+#include <algorithm>
+#include "gram.h"
+
+/*---------------------------------------------------------------------------*/
+GramMatrix::GramMatrix(int k, std::vector<long double> const& data) :
+  Mk(k), Mdata(data)
+{
+  if (0 >= Mk || Mdata.size() != size_t(Mk*Mk))
+  {
+    throw std::string("Illegal Gram matrix data.");
+  }
+} // constructor GramMatrix
+
+/*---------------------------------------------------------------------------*/
+GramMatrix::GramMatrix(std::vector<double const*> const& columns, int n) :
+  Mk(columns.size()), Mdata(columns.size()*columns.size(), 0.L)
+{
+  if (0 == Mk || 0 >= n)
+  {
+    throw std::string("Gram matrix of empty time series requested.");
+  }
+  // accumulate the upper triangle
+  std::vector<long double> values(Mk);
+  for (int l=0; l<n; ++l)
+  {
+    for (int i=0; i<Mk; ++i) { values[i] = columns[i][l]; }
+    for (int i=0; i<Mk; ++i)
+    {
+      for (int k=i; k<Mk; ++k)
+      {
+        Mdata[i*Mk+k] += values[i]*values[k];
+      }
+    }
+  }
+  // mirror to the lower triangle
+  for (int i=0; i<Mk; ++i)
+  {
+    for (int k=0; k<i; ++k) { Mdata[i*Mk+k] = Mdata[k*Mk+i]; }
+  }
+} // constructor GramMatrix
+
+/*---------------------------------------------------------------------------*/
+double GramMatrix::quadraticForm(double const* coefficients) const
+{
+  long double sum = 0;
+  for (int i=0; i<Mk; ++i)
+  {
+    long double row = 0;
+    for (int k=0; k<Mk; ++k)
+    {
+      row += Mdata[i*Mk+k]*coefficients[k];
+    }
+    sum += coefficients[i]*row;
+  }
+  return sum < 0 ? 0. : static_cast<double>(sum);
+} // function GramMatrix::quadraticForm
+
+/*---------------------------------------------------------------------------*/
+double GramMatrix::minimize(double* coefficients,
+    std::vector<int> const& free) const
+{
+  int const m = free.size();
+  if (m)
+  {
+    // set up the normal equations as augmented matrix
+    std::vector<bool> isFree(Mk, false);
+    for (int i=0; i<m; ++i) { isFree.at(free[i]) = true; }
+    std::vector<long double> a(m*(m+1));
+    for (int i=0; i<m; ++i)
+    {
+      long double rhs = 0;
+      for (int k=0; k<Mk; ++k)
+      {
+        if (! isFree[k]) { rhs -= Mdata[free[i]*Mk+k]*coefficients[k]; }
+      }
+      for (int k=0; k<m; ++k) { a[i*(m+1)+k] = Mdata[free[i]*Mk+free[k]]; }
+      a[i*(m+1)+m] = rhs;
+    }
+    // Gauss-Jordan elimination with partial pivoting
+    long double const eps = 1e-12L;
+    std::vector<bool> dependent(m, false);
+    for (int k=0; k<m; ++k)
+    {
+      int pivot = k;
+      for (int i=k+1; i<m; ++i)
+      {
+        if (fabsl(a[i*(m+1)+k]) > fabsl(a[pivot*(m+1)+k])) { pivot = i; }
+      }
+      if (fabsl(a[pivot*(m+1)+k]) <=
+          eps*fabsl(Mdata[free[k]*Mk+free[k]]))
+      {
+        dependent[k] = true;
+        continue;
+      }
+      for (int j=0; j<=m; ++j)
+      {
+        std::swap(a[k*(m+1)+j], a[pivot*(m+1)+j]);
+      }
+      for (int i=0; i<m; ++i)
+      {
+        if (i == k) { continue; }
+        long double const factor = a[i*(m+1)+k]/a[k*(m+1)+k];
+        for (int j=k; j<=m; ++j) { a[i*(m+1)+j] -= factor*a[k*(m+1)+j]; }
+      }
+    }
+    for (int k=0; k<m; ++k)
+    {
+      coefficients[free[k]] = dependent[k] ? 0. :
+        static_cast<double>(a[k*(m+1)+m]/a[k*(m+1)+k]);
+    }
+  }
+  return quadraticForm(coefficients);
+} // function GramMatrix::minimize
+
+/* ----- END OF gram.cc  ----- */
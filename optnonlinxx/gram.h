@@ -0,0 +1,129 @@
+/*! \file gram.h
+ * \brief Declaration of the Gram matrix of the optnonlin regressors.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Declaration of the Gram matrix of the optnonlin regressors. The
+ * residual of the seismometer model equation is linear in its coefficients.
+ * Thus the sum of the squared residual of every parameter configuration
+ * follows from the matrix of inner products of the regressor time series
+ * which only has to be computed once.
+ *
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  Minimization with respect to selected coefficients.
+ * 16/10/2026  V0.3  Construction from stored inner products.
+ *
+ * ============================================================================
+ */
+
+#include <vector>
+
+#ifndef _OPTNONLIN_GRAM_H_
+#define _OPTNONLIN_GRAM_H_
+
+/*!
+ * symmetric matrix of the inner products
+ * \f[
+ *    G_{ik} = \sum_{l=1}^N x_{i,l}x_{k,l}
+ * \f]
+ * of the regressor time series \f$x_i\f$.
+ *
+ * With the coefficient vector \f$c\f$ of a parameter configuration the sum
+ * of the squared residual is
+ * \f[
+ *    \sum_{l=1}^N\left(\sum_i c_ix_{i,l}\right)^2 = c^TGc
+ * \f]
+ * which costs \f$O(k^2)\f$ instead of \f$O(N)\f$ operations.
+ *
+ * The entries are accumulated in extended precision. Nevertheless the
+ * quadratic form suffers from cancellation if the residual is small
+ * compared to the regressors.
+ */
+class GramMatrix
+{
+  public:
+    /*!
+     * constructor computing the inner products within a single pass over
+     * the samples
+     *
+     * \param columns pointers to the first sample of each regressor
+     * \param n number of samples of each regressor
+     */
+    GramMatrix(std::vector<double const*> const& columns, int n);
+    /*!
+     * constructor restoring stored inner products
+     *
+     * \param k number of regressors
+     * \param data row-major matrix data as returned by data()
+     */
+    GramMatrix(int k, std::vector<long double> const& data);
+    //! number of regressors
+    int size() const { return Mk; }
+    //! query an inner product
+    double operator()(int i, int k) const { return Mdata[i*Mk+k]; }
+    //! row-major matrix data in extended precision
+    std::vector<long double> const& data() const { return Mdata; }
+    /*!
+     * compute the quadratic form \f$c^TGc\f$
+     *
+     * \param coefficients array of size() coefficients
+     *
+     * \return sum of the squared residual; negative values due to rounding
+     * errors are truncated to zero
+     */
+    double quadraticForm(double const* coefficients) const;
+    /*!
+     * minimize the quadratic form \f$c^TGc\f$ with respect to selected
+     * coefficients while keeping the others fixed
+     *
+     * Solves the normal equations
+     * \f[
+     *    G_{UU}c_U = -G_{UF}c_F
+     * \f]
+     * where \f$U\f$ are the indices of the free and \f$F\f$ the indices
+     * of the fixed coefficients. Free coefficients of (numerically) linearly
+     * dependent regressors are set to zero.
+     *
+     * \param coefficients array of size() coefficients; the free
+     * coefficients are replaced by their optimal values
+     * \param free indices of the free coefficients
+     *
+     * \return minimum of the quadratic form
+     */
+    double minimize(double* coefficients, std::vector<int> const& free) const;
+
+  private:
+    //! number of regressors
+    int Mk;
+    //! row-major matrix data
+    std::vector<long double> Mdata;
+
+}; // class GramMatrix
+
+#endif // include guard
+
+/* ----- END OF gram.h  ----- */
@@ -0,0 +1,183 @@
+/*! \file implicitgrid.cc
+ * \brief Implementation of the implicit parameter space grid.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Implementation of the implicit parameter space grid.
+ *
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <string>
+#include <limits>
+#include <algorithm>
+#include <boost/thread.hpp>
+#include "implicitgrid.h"
+
+/* -------------------------------------------------------------------------- */
+std::vector<std::string> ImplicitGrid::storedColumns(
+    std::vector<std::string> const& columns)
+{
+  if (3 > columns.size())
+  {
+    throw std::string("Illegal result columns of implicit grid.");
+  }
+  // RMS misfit and profiled parameters; MD misfit and pruned flag are not
+  // stored
+  return std::vector<std::string>(columns.begin()+1, columns.end()-1);
+} // function ImplicitGrid::storedColumns
+
+/* -------------------------------------------------------------------------- */
+ImplicitGrid::ImplicitGrid(std::vector<std::vector<TcoordType>> const& axes,
+    std::vector<std::string> const& columns, bool single_precision) :
+  Maxes(axes), Msize(1), Mvalues(columns.size()),
+  Mstore(storedColumns(columns), single_precision), Mnext(0)
+{
+  if (Maxes.empty()) { throw std::string("Empty parameter space."); }
+  for (auto cit(Maxes.cbegin()); cit != Maxes.cend(); ++cit)
+  {
+    if (cit->empty()) { throw std::string("Empty grid axis."); }
+    if (Msize > std::numeric_limits<size_t>::max()/cit->size())
+    {
+      throw std::string("Too many nodes of implicit grid.");
+    }
+    Msize *= cit->size();
+  }
+  Mstore.resize(Msize);
+} // ImplicitGrid::ImplicitGrid
+
+/* -------------------------------------------------------------------------- */
+void ImplicitGrid::coordinates(size_t index,
+    std::vector<TcoordType>& result) const
+{
+  if (index >= Msize) { throw std::string("Illegal node index."); }
+  result.resize(Maxes.size());
+  for (size_t i=Maxes.size(); i-- > 0; )
+  {
+    result[i] = Maxes[i][index % Maxes[i].size()];
+    index /= Maxes[i].size();
+  }
+} // function ImplicitGrid::coordinates
+
+/* -------------------------------------------------------------------------- */
+std::unique_ptr<TnodeType> ImplicitGrid::node(size_t index) const
+{
+  std::vector<TcoordType> c;
+  coordinates(index, c);
+  return std::unique_ptr<TnodeType>(new TnodeType(c));
+} // function ImplicitGrid::node
+
+/* -------------------------------------------------------------------------- */
+void ImplicitGrid::execute(
+    opt::ParameterSpaceVisitor<TcoordType, TresultType>& visitor,
+    size_t batch_size, size_t num_threads)
+{
+  if (0 == batch_size) { throw std::string("Illegal batch size."); }
+  if (0 == num_threads) { num_threads = 1; }
+  Mnext = 0;
+  boost::thread_group threads;
+  for (size_t i=1; i<num_threads; ++i)
+  {
+    threads.create_thread(boost::bind(&ImplicitGrid::work, this,
+          boost::ref(visitor), batch_size));
+  }
+  work(visitor, batch_size);
+  threads.join_all();
+} // function ImplicitGrid::execute
+
+/* -------------------------------------------------------------------------- */
+void ImplicitGrid::work(
+    opt::ParameterSpaceVisitor<TcoordType, TresultType>& visitor,
+    size_t batch_size)
+{
+  BatchVisitor* batch = dynamic_cast<BatchVisitor*>(&visitor);
+  std::vector<std::unique_ptr<TnodeType>> nodes(batch_size);
+  std::vector<TnodeType*> pointers(batch_size);
+  while (true)
+  {
+    size_t const first = Mnext.fetch_add(batch_size);
+    if (first >= Msize) { return; }
+    int const count = std::min(batch_size, Msize-first);
+    for (int i=0; i<count; ++i)
+    {
+      nodes[i] = node(first+i);
+      pointers[i] = nodes[i].get();
+    }
+    if (batch)
+    {
+      batch->visitBatch(&pointers[0], count);
+    } else
+    {
+      for (int i=0; i<count; ++i) { visitor(pointers[i]); }
+    }
+    for (int i=0; i<count; ++i)
+    {
+      store(first+i, pointers[i]->getResultData());
+    }
+  }
+} // function ImplicitGrid::work
+
+/* -------------------------------------------------------------------------- */
+TresultType ImplicitGrid::result(size_t index) const
+{
+  auto const it = Mkept.find(index);
+  if (it != Mkept.end()) { return it->second; }
+  double const nan = std::numeric_limits<double>::quiet_NaN();
+  double const value = rms(index);
+  if (! (value == value)) { return TresultType(nan, nan, true); }
+  std::vector<double> parameters(Mvalues-3);
+  for (size_t i=0; i<parameters.size(); ++i)
+  {
+    parameters[i] = Mstore.value(index, i+1);
+  }
+  return TresultType(nan, value, parameters);
+} // function ImplicitGrid::result
+
+/* -------------------------------------------------------------------------- */
+void ImplicitGrid::store(size_t index, TresultType const& result)
+{
+  if (index >= Msize) { throw std::string("Illegal node index."); }
+  double const nan = std::numeric_limits<double>::quiet_NaN();
+  Mstore.set(index, 0, result.isPruned() ? nan : result.getRmsMisfit());
+  std::vector<double> const& parameters = result.getParameters();
+  for (size_t i=1; i<Mstore.columns(); ++i)
+  {
+    Mstore.set(index, i, i <= parameters.size() ? parameters[i-1] : nan);
+  }
+} // function ImplicitGrid::store
+
+/* -------------------------------------------------------------------------- */
+void ImplicitGrid::keep(size_t index, TresultType const& result)
+{
+  store(index, result);
+  Mkept[index] = result;
+} // function ImplicitGrid::keep
+
+/* ----- END OF implicitgrid.cc  ----- */
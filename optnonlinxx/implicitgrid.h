@@ -0,0 +1,157 @@
+/*! \file implicitgrid.h
+ * \brief Declaration of the implicit parameter space grid.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Declaration of the implicit parameter space grid. Instead of one
+ * node object per grid point a node is addressed by its linear index. The
+ * coordinates are decoded from the index when the node is evaluated and
+ * the result values are kept in a columnar ResultStore. Thus the grid takes
+ * a few bytes per node and no time to construct. Node objects exist only
+ * for the blocks of nodes currently evaluated and for the best nodes
+ * finally reported.
+ *
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <cstddef>
+#include <vector>
+#include <memory>
+#include <map>
+#include <atomic>
+#include <optimizexx/application.h>
+#include "types.h"
+#include "batch.h"
+#include "../commonxx/resultstore.h"
+
+#ifndef _OPTNONLIN_IMPLICITGRID_H_
+#define _OPTNONLIN_IMPLICITGRID_H_
+
+/*!
+ * parameter space grid addressed by linear node indices
+ *
+ * The index is row major with respect to the axes, i.e. the last axis
+ * varies fastest, like the index of GridIndex. Only the RMS misfit of a
+ * node and its profiled parameters (variable projection) are stored, i.e.
+ * 4 or 8 bytes per value and node. Complete results are kept for nodes
+ * explicitly passed to keep().
+ */
+class ImplicitGrid
+{
+  public:
+    /*!
+     * constructor
+     *
+     * \param axes values of the axes in the order of the node coordinates
+     * \param columns names of the values of a result as appended by
+     * OptResult::appendValues() (MD and RMS misfit first, pruned flag
+     * last); results returned by result() have the same values
+     * \param single_precision flag if the RMS misfit is stored as \c float
+     */
+    ImplicitGrid(std::vector<std::vector<TcoordType>> const& axes,
+        std::vector<std::string> const& columns,
+        bool single_precision=false);
+    //! number of nodes
+    size_t size() const { return Msize; }
+    //! decode the coordinates of the node with index \a index
+    void coordinates(size_t index, std::vector<TcoordType>& result) const;
+    //! create the node with index \a index (result not computed)
+    std::unique_ptr<TnodeType> node(size_t index) const;
+    /*!
+     * evaluate all nodes
+     *
+     * The nodes are dispensed to the threads in blocks of \a batch_size
+     * consecutive indices. Visitors implementing BatchVisitor evaluate the
+     * block at once, all other visitors node by node. The visitor must be
+     * safe to call from several threads.
+     *
+     * \param visitor visitor computing the results
+     * \param batch_size number of nodes in a block
+     * \param num_threads number of threads to start
+     */
+    void execute(opt::ParameterSpaceVisitor<TcoordType, TresultType>& visitor,
+        size_t batch_size, size_t num_threads);
+    /*!
+     * RMS misfit of the node with index \a index
+     *
+     * NaN for pruned nodes and nodes not evaluated yet.
+     */
+    double rms(size_t index) const { return Mstore.value(index, 0); }
+    /*!
+     * result of the node with index \a index
+     *
+     * The complete result of nodes passed to keep(). Otherwise the MD
+     * misfit is NaN, and nodes without RMS misfit are reported as pruned.
+     */
+    TresultType result(size_t index) const;
+    /*!
+     * store the RMS misfit and the profiled parameters of the node with
+     * index \a index
+     *
+     * The misfit of pruned nodes is incomplete and stored as NaN.
+     */
+    void store(size_t index, TresultType const& result);
+    /*!
+     * keep the complete result of the node with index \a index
+     *
+     * Not thread safe; meant for a few selected nodes.
+     */
+    void keep(size_t index, TresultType const& result);
+    //! indices of the \a k nodes of least RMS misfit (best first)
+    std::vector<size_t> best(size_t k) const { return Mstore.best(0, k); }
+    //! results of the nodes
+    ResultStore const& store() const { return Mstore; }
+
+  private:
+    //! names of the stored columns
+    static std::vector<std::string> storedColumns(
+        std::vector<std::string> const& columns);
+    //! evaluate blocks of nodes until all are dispensed (worker thread)
+    void work(opt::ParameterSpaceVisitor<TcoordType, TresultType>& visitor,
+        size_t batch_size);
+
+    //! axis values
+    std::vector<std::vector<TcoordType>> Maxes;
+    //! number of nodes
+    size_t Msize;
+    //! number of values of a result
+    size_t Mvalues;
+    //! RMS misfit and profiled parameters of the nodes
+    ResultStore Mstore;
+    //! complete results of selected nodes
+    std::map<size_t, TresultType> Mkept;
+    //! first index of the next block to dispense
+    std::atomic<size_t> Mnext;
+
+}; // class ImplicitGrid
+
+#endif // include guard
+
+/* ----- END OF implicitgrid.h  ----- */
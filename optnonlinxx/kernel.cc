@@ -0,0 +1,424 @@
+/*! \file kernel.cc
+ * \brief Implementation of the fused misfit kernels of optnonlin.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Implementation of the fused misfit kernels of optnonlin.
+ *
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  runtime dispatch of vectorized kernels
+ * 16/10/2026  V0.3  batched kernels evaluating several nodes tile by tile
+ * 16/10/2026  V0.4  single precision kernels
+ *
+ * ============================================================================
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "kernel.h"
+#include "simd.h"
+
+namespace kernel
+{
+
+  namespace
+  {
+    //! table of the kernels of one instruction set extension
+    struct Kernels
+    {
+      Tisa isa;
+      MisfitSums (*norms)(double const*, int);
+      MisfitSums (*linear)(double const*, double const*, double const*,
+          double const*, int, double, double);
+      MisfitSums (*nonlinear)(double const*, double const*, double const*,
+          double const*, double const*, double const*, int, double, double,
+          double, double);
+      MisfitSums (*normsF)(float const*, int);
+      MisfitSums (*linearF)(float const*, float const*, float const*,
+          float const*, int, double, double);
+      MisfitSums (*nonlinearF)(float const*, float const*, float const*,
+          float const*, float const*, float const*, int, double, double,
+          double, double);
+    }; // struct Kernels
+
+    /* SSE2 provides no benefit for single precision kernels since the sums
+     * are accumulated in double precision. AVX-512 uses the AVX2 single
+     * precision kernels. */
+    Kernels const scalarKernels =
+      { Scalar, scalar::norms, scalar::linear, scalar::nonlinear,
+        scalar::norms, scalar::linear, scalar::nonlinear };
+#ifdef OPTNONLIN_X86_KERNELS
+    Kernels const sse2Kernels =
+      { SSE2, sse2::norms, sse2::linear, sse2::nonlinear,
+        scalar::norms, scalar::linear, scalar::nonlinear };
+    Kernels const avx2Kernels =
+      { AVX2, avx2::norms, avx2::linear, avx2::nonlinear,
+        avx2::norms, avx2::linear, avx2::nonlinear };
+    Kernels const avx512Kernels =
+      { AVX512, avx512::norms, avx512::linear, avx512::nonlinear,
+        avx2::norms, avx2::linear, avx2::nonlinear };
+#endif
+
+    //! kernel table for an instruction set extension
+    Kernels const& kernelsFor(Tisa isa)
+    {
+#ifdef OPTNONLIN_X86_KERNELS
+      switch (isa)
+      {
+        case SSE2: return sse2Kernels;
+        case AVX2: return avx2Kernels;
+        case AVX512: return avx512Kernels;
+        default: break;
+      }
+#endif
+      return scalarKernels;
+    }
+
+    //! currently selected kernels
+    Kernels const* active = &kernelsFor(detect());
+  } // namespace (unnamed)
+
+  /* ----------------------------------------------------------------------- */
+  bool supported(Tisa isa)
+  {
+    if (Scalar == isa) { return true; }
+#ifdef OPTNONLIN_X86_KERNELS
+    __builtin_cpu_init();
+    switch (isa)
+    {
+      case SSE2: return __builtin_cpu_supports("sse2");
+      case AVX2: return __builtin_cpu_supports("avx2");
+      case AVX512: return __builtin_cpu_supports("avx512f");
+      default: break;
+    }
+#endif
+    return false;
+  } // function supported
+
+  /* ----------------------------------------------------------------------- */
+  Tisa detect()
+  {
+    if (supported(AVX512)) { return AVX512; }
+    if (supported(AVX2)) { return AVX2; }
+    if (supported(SSE2)) { return SSE2; }
+    return Scalar;
+  } // function detect
+
+  /* ----------------------------------------------------------------------- */
+  Tisa isaFromString(std::string const& name)
+  {
+    if ("auto" == name) { return detect(); }
+    if ("scalar" == name) { return Scalar; }
+    if ("sse2" == name) { return SSE2; }
+    if ("avx2" == name) { return AVX2; }
+    if ("avx512" == name) { return AVX512; }
+    throw std::string("Unknown kernel '"+name+"'.");
+  } // function isaFromString
+
+  /* ----------------------------------------------------------------------- */
+  std::string isaName(Tisa isa)
+  {
+    switch (isa)
+    {
+      case SSE2: return "sse2";
+      case AVX2: return "avx2";
+      case AVX512: return "avx512";
+      default: break;
+    }
+    return "scalar";
+  } // function isaName
+
+  /* ----------------------------------------------------------------------- */
+  void select(Tisa isa)
+  {
+    if (! supported(isa))
+    {
+      throw std::string("Kernel '"+isaName(isa)+"' not supported by CPU.");
+    }
+    active = &kernelsFor(isa);
+  } // function select
+
+  /* ----------------------------------------------------------------------- */
+  Tisa selected() { return active->isa; }
+
+  /* ----------------------------------------------------------------------- */
+  MisfitSums norms(double const* in, int n)
+  {
+    return active->norms(in, n);
+  } // function norms
+
+  /* ----------------------------------------------------------------------- */
+  MisfitSums linear(double const* in, double const* y_dif2,
+      double const* y_dif, double const* y, int n, double a1, double a2)
+  {
+    return active->linear(in, y_dif2, y_dif, y, n, a1, a2);
+  } // function linear
+
+  /* ----------------------------------------------------------------------- */
+  MisfitSums nonlinear(double const* in, double const* y_dif2,
+      double const* y_dif, double const* y, double const* y_square,
+      double const* y_cube, int n, double a1, double a2, double c0,
+      double c1)
+  {
+    return active->nonlinear(in, y_dif2, y_dif, y, y_square, y_cube, n, a1,
+        a2, c0, c1);
+  } // function nonlinear
+
+  /* ----------------------------------------------------------------------- */
+  MisfitSums norms(float const* in, int n)
+  {
+    return active->normsF(in, n);
+  } // function norms
+
+  /* ----------------------------------------------------------------------- */
+  MisfitSums linear(float const* in, float const* y_dif2,
+      float const* y_dif, float const* y, int n, double a1, double a2)
+  {
+    return active->linearF(in, y_dif2, y_dif, y, n, a1, a2);
+  } // function linear
+
+  /* ----------------------------------------------------------------------- */
+  MisfitSums nonlinear(float const* in, float const* y_dif2,
+      float const* y_dif, float const* y, float const* y_square,
+      float const* y_cube, int n, double a1, double a2, double c0,
+      double c1)
+  {
+    return active->nonlinearF(in, y_dif2, y_dif, y, y_square, y_cube, n, a1,
+        a2, c0, c1);
+  } // function nonlinear
+
+  /* ----------------------------------------------------------------------- */
+  namespace
+  {
+    template <typename Tvalue>
+    void linearBatchT(Tvalue const* in, Tvalue const* y_dif2,
+        Tvalue const* y_dif, Tvalue const* y, int n, int m, double const* a1,
+        double const* a2, MisfitSums* sums)
+    {
+      for (int i=0; i<m; ++i) { sums[i] = MisfitSums(); }
+      for (int j=0; j<n; j+=tileSize)
+      {
+        int const len = std::min(tileSize, n-j);
+        for (int i=0; i<m; ++i)
+        {
+          MisfitSums const tile = linear(in+j, y_dif2+j, y_dif+j, y+j,
+              len, a1[i], a2[i]);
+          sums[i].md += tile.md;
+          sums[i].rms += tile.rms;
+        }
+      }
+    } // function linearBatchT
+
+    template <typename Tvalue>
+    void nonlinearBatchT(Tvalue const* in, Tvalue const* y_dif2,
+        Tvalue const* y_dif, Tvalue const* y, Tvalue const* y_square,
+        Tvalue const* y_cube, int n, int m, double const* a1,
+        double const* a2, double const* c0, double const* c1,
+        MisfitSums* sums)
+    {
+      for (int i=0; i<m; ++i) { sums[i] = MisfitSums(); }
+      for (int j=0; j<n; j+=tileSize)
+      {
+        int const len = std::min(tileSize, n-j);
+        for (int i=0; i<m; ++i)
+        {
+          MisfitSums const tile = nonlinear(in+j, y_dif2+j, y_dif+j,
+              y+j, y_square+j, y_cube+j, len, a1[i], a2[i], c0[i], c1[i]);
+          sums[i].md += tile.md;
+          sums[i].rms += tile.rms;
+        }
+      }
+    } // function nonlinearBatchT
+  } // namespace (unnamed)
+
+  /* ----------------------------------------------------------------------- */
+  void linearBatch(double const* in, double const* y_dif2,
+      double const* y_dif, double const* y, int n, int m, double const* a1,
+      double const* a2, MisfitSums* sums)
+  {
+    linearBatchT(in, y_dif2, y_dif, y, n, m, a1, a2, sums);
+  } // function linearBatch
+
+  /* ----------------------------------------------------------------------- */
+  void linearBatch(float const* in, float const* y_dif2,
+      float const* y_dif, float const* y, int n, int m, double const* a1,
+      double const* a2, MisfitSums* sums)
+  {
+    linearBatchT(in, y_dif2, y_dif, y, n, m, a1, a2, sums);
+  } // function linearBatch
+
+  /* ----------------------------------------------------------------------- */
+  void nonlinearBatch(double const* in, double const* y_dif2,
+      double const* y_dif, double const* y, double const* y_square,
+      double const* y_cube, int n, int m, double const* a1, double const* a2,
+      double const* c0, double const* c1, MisfitSums* sums)
+  {
+    nonlinearBatchT(in, y_dif2, y_dif, y, y_square, y_cube, n, m, a1, a2,
+        c0, c1, sums);
+  } // function nonlinearBatch
+
+  /* ----------------------------------------------------------------------- */
+  void nonlinearBatch(float const* in, float const* y_dif2,
+      float const* y_dif, float const* y, float const* y_square,
+      float const* y_cube, int n, int m, double const* a1, double const* a2,
+      double const* c0, double const* c1, MisfitSums* sums)
+  {
+    nonlinearBatchT(in, y_dif2, y_dif, y, y_square, y_cube, n, m, a1, a2,
+        c0, c1, sums);
+  } // function nonlinearBatch
+
+  /* ======================================================================= */
+  namespace scalar
+  {
+    namespace
+    {
+      //! compensated (Kahan) summation in double precision
+      class KahanSum
+      {
+        public:
+          KahanSum() : Msum(0), Mcompensation(0) { }
+          void add(double value)
+          {
+            double const y = value - Mcompensation;
+            double const t = Msum + y;
+            Mcompensation = (t - Msum) - y;
+            Msum = t;
+          }
+          double sum() const { return Msum; }
+        private:
+          double Msum;
+          double Mcompensation;
+      }; // class KahanSum
+    } // namespace (unnamed)
+
+    /* --------------------------------------------------------------------- */
+    MisfitSums norms(double const* in, int n)
+    {
+      MisfitSums sums;
+      for (int j=0; j<n; ++j)
+      {
+        sums.md += fabs(in[j]);
+        sums.rms += in[j]*in[j];
+      }
+      return sums;
+    } // function norms
+
+    /* --------------------------------------------------------------------- */
+    MisfitSums linear(double const* in, double const* y_dif2,
+        double const* y_dif, double const* y, int n, double a1, double a2)
+    {
+      MisfitSums sums;
+      for (int j=0; j<n; ++j)
+      {
+        double const r = fabs(y_dif2[j] + a1*y_dif[j] + a2*y[j] - in[j]);
+        sums.md += r;
+        sums.rms += r*r;
+      }
+      return sums;
+    } // function linear
+
+    /* --------------------------------------------------------------------- */
+    MisfitSums nonlinear(double const* in, double const* y_dif2,
+        double const* y_dif, double const* y, double const* y_square,
+        double const* y_cube, int n, double a1, double a2, double c0,
+        double c1)
+    {
+      MisfitSums sums;
+      for (int j=0; j<n; ++j)
+      {
+        double const r = fabs(y_dif2[j] + a1*y_dif[j] + a2*y[j] +
+            c0*y_square[j] + c1*y_cube[j] - in[j]);
+        sums.md += r;
+        sums.rms += r*r;
+      }
+      return sums;
+    } // function nonlinear
+
+    /* --------------------------------------------------------------------- */
+    MisfitSums norms(float const* in, int n)
+    {
+      KahanSum md, rms;
+      for (int j=0; j<n; ++j)
+      {
+        double const v = in[j];
+        md.add(fabs(v));
+        rms.add(v*v);
+      }
+      MisfitSums sums;
+      sums.md = md.sum();
+      sums.rms = rms.sum();
+      return sums;
+    } // function norms
+
+    /* --------------------------------------------------------------------- */
+    MisfitSums linear(float const* in, float const* y_dif2,
+        float const* y_dif, float const* y, int n, double a1, double a2)
+    {
+      float const fa1 = a1;
+      float const fa2 = a2;
+      KahanSum md, rms;
+      for (int j=0; j<n; ++j)
+      {
+        double const r = fabsf(y_dif2[j] + fa1*y_dif[j] + fa2*y[j] - in[j]);
+        md.add(r);
+        rms.add(r*r);
+      }
+      MisfitSums sums;
+      sums.md = md.sum();
+      sums.rms = rms.sum();
+      return sums;
+    } // function linear
+
+    /* --------------------------------------------------------------------- */
+    MisfitSums nonlinear(float const* in, float const* y_dif2,
+        float const* y_dif, float const* y, float const* y_square,
+        float const* y_cube, int n, double a1, double a2, double c0,
+        double c1)
+    {
+      float const fa1 = a1;
+      float const fa2 = a2;
+      float const fc0 = c0;
+      float const fc1 = c1;
+      KahanSum md, rms;
+      for (int j=0; j<n; ++j)
+      {
+        double const r = fabsf(y_dif2[j] + fa1*y_dif[j] + fa2*y[j] +
+            fc0*y_square[j] + fc1*y_cube[j] - in[j]);
+        md.add(r);
+        rms.add(r*r);
+      }
+      MisfitSums sums;
+      sums.md = md.sum();
+      sums.rms = rms.sum();
+      return sums;
+    } // function nonlinear
+
+  } // namespace scalar
+
+} // namespace kernel
+
+/* ----- END OF kernel.cc  ----- */
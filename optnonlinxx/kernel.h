@@ -0,0 +1,256 @@
+/*! \file kernel.h
+ * \brief Declaration of the fused misfit kernels of optnonlin.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Declaration of the fused misfit kernels of optnonlin. A kernel
+ * computes the residual of the seismometer model equation and accumulates
+ * the numerators of the MD and RMS misfit within a single pass over the
+ * samples without allocating any temporary time series.
+ *
+ * Besides of the scalar reference kernels there are vectorized kernels for
+ * several instruction set extensions. The kernel used is selected at runtime
+ * and defaults to the best one the CPU supports.
+ *
+ * All kernels are available for single precision samples, too. Single
+ * precision kernels compute the residual in single precision but accumulate
+ * the sums in double precision.
+ *
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  runtime dispatch of vectorized kernels
+ * 16/10/2026  V0.3  batched kernels evaluating several nodes tile by tile
+ * 16/10/2026  V0.4  single precision kernels
+ *
+ * ============================================================================
+ */
+
+#include <string>
+#include <datrwxx/types.h>
+
+#ifndef _OPTNONLIN_KERNEL_H_
+#define _OPTNONLIN_KERNEL_H_
+
+namespace kernel
+{
+  /*!
+   * accumulators of a misfit computation
+   *
+   * Depending on the context the sums either hold the numerators (sums of
+   * the residual) or the denominators (sums of the calibration signal) of
+   * the MD and RMS misfit.
+   */
+  struct MisfitSums
+  {
+    MisfitSums() : md(0), rms(0) { }
+    //! sum of absolute values
+    double md;
+    //! sum of squares
+    double rms;
+  }; // struct MisfitSums
+
+  /*!
+   * pointer to the first sample of a time series
+   *
+   * \a aff::Series stores its samples contiguously so the kernels are able to
+   * run on plain pointers.
+   */
+  inline double const* samples(datrw::Tdseries const& series)
+  {
+    return &series(series.f());
+  }
+
+  //! pointer to the first sample of a single precision time series
+  inline float const* samples(datrw::Tfseries const& series)
+  {
+    return &series(series.f());
+  }
+
+  //! instruction set extensions kernels are available for
+  enum Tisa
+  {
+    Scalar,   //!< portable scalar reference kernels
+    SSE2,     //!< kernels using SSE2
+    AVX2,     //!< kernels using AVX2
+    AVX512    //!< kernels using AVX-512F
+  }; // enum Tisa
+
+  //! determine the best instruction set extension supported by the CPU
+  Tisa detect();
+  //! check if the CPU supports kernels of an instruction set extension
+  bool supported(Tisa isa);
+  /*!
+   * convert a name (\c scalar, \c sse2, \c avx2, \c avx512 or \c auto) into
+   * an instruction set extension
+   *
+   * \c auto refers to the result of detect().
+   */
+  Tisa isaFromString(std::string const& name);
+  //! name of an instruction set extension
+  std::string isaName(Tisa isa);
+  /*!
+   * select the kernels of an instruction set extension
+   *
+   * Must be called before any threads are started. By default the kernels
+   * returned by detect() are used.
+   */
+  void select(Tisa isa);
+  //! instruction set extension of the currently selected kernels
+  Tisa selected();
+
+  /*!
+   * accumulate the sums of the calibration input signal which are the
+   * denominators of the MD and RMS misfit
+   *
+   * \param in calibration input signal
+   * \param n number of samples
+   */
+  MisfitSums norms(double const* in, int n);
+
+  /*!
+   * fused misfit kernel of the linear seismometer model
+   * \f[
+   *    r_l = \ddot{y}_l + a_1\dot{y}_l + a_2y_l - \ddot{u}_l
+   * \f]
+   *
+   * The scalar kernel evaluates the residual in the same order of operations
+   * the former separate passes did, so its results are bit-identical.
+   * Vectorized kernels differ in the order of summation.
+   *
+   * \param in calibration input signal
+   * \param y_dif2 second derivative of the output signal
+   * \param y_dif derivative of the output signal
+   * \param y output signal
+   * \param n number of samples
+   * \param a1 factor of the first derivative
+   * \param a2 factor of the output signal
+   *
+   * \return sums of \f$|r_l|\f$ and \f$r_l^2\f$
+   */
+  MisfitSums linear(double const* in, double const* y_dif2,
+      double const* y_dif, double const* y, int n, double a1, double a2);
+
+  /*!
+   * fused misfit kernel of the nonlinear seismometer model
+   * \f[
+   *    r_l = \ddot{y}_l + a_1\dot{y}_l + a_2y_l + c_0y_l^2 + c_1y_l^3
+   *      - \ddot{u}_l
+   * \f]
+   *
+   * \param y_square square of the output signal
+   * \param y_cube cube of the output signal
+   * \param c0 factor of the squared output signal
+   * \param c1 factor of the cubed output signal
+   *
+   * For the remaining parameters see kernel::linear.
+   */
+  MisfitSums nonlinear(double const* in, double const* y_dif2,
+      double const* y_dif, double const* y, double const* y_square,
+      double const* y_cube, int n, double a1, double a2, double c0,
+      double c1);
+
+  /*!
+   * single precision variants of the kernels
+   *
+   * The residual is computed in single precision, so twice the number of
+   * samples fits into a vector register. The sums are accumulated in double
+   * precision; the scalar kernels use Kahan summation, the vectorized
+   * kernels accumulate in separate double precision lanes.
+   */
+  MisfitSums norms(float const* in, int n);
+  //! single precision variant of kernel::linear
+  MisfitSums linear(float const* in, float const* y_dif2,
+      float const* y_dif, float const* y, int n, double a1, double a2);
+  //! single precision variant of kernel::nonlinear
+  MisfitSums nonlinear(float const* in, float const* y_dif2,
+      float const* y_dif, float const* y, float const* y_square,
+      float const* y_cube, int n, double a1, double a2, double c0,
+      double c1);
+
+  /*!
+   * number of samples of a tile processed by the batched kernels
+   *
+   * A tile of all regressors of the nonlinear model (6 series, 96 kB)
+   * fits into the L2 cache, so it is loaded from memory only once for all
+   * nodes of a batch.
+   */
+  int const tileSize = 2048;
+
+  /*!
+   * batched misfit kernel of the linear seismometer model
+   *
+   * Evaluates \p m parameter configurations tile by tile. The sums of node
+   * \p i are computed with the coefficients \p a1[i] and \p a2[i] and are
+   * written to \p sums[i]. For the remaining parameters see kernel::linear.
+   */
+  void linearBatch(double const* in, double const* y_dif2,
+      double const* y_dif, double const* y, int n, int m, double const* a1,
+      double const* a2, MisfitSums* sums);
+
+  /*!
+   * batched misfit kernel of the nonlinear seismometer model
+   *
+   * See kernel::linearBatch and kernel::nonlinear.
+   */
+  void nonlinearBatch(double const* in, double const* y_dif2,
+      double const* y_dif, double const* y, double const* y_square,
+      double const* y_cube, int n, int m, double const* a1, double const* a2,
+      double const* c0, double const* c1, MisfitSums* sums);
+
+  //! single precision variant of kernel::linearBatch
+  void linearBatch(float const* in, float const* y_dif2,
+      float const* y_dif, float const* y, int n, int m, double const* a1,
+      double const* a2, MisfitSums* sums);
+  //! single precision variant of kernel::nonlinearBatch
+  void nonlinearBatch(float const* in, float const* y_dif2,
+      float const* y_dif, float const* y, float const* y_square,
+      float const* y_cube, int n, int m, double const* a1, double const* a2,
+      double const* c0, double const* c1, MisfitSums* sums);
+
+  /*! portable reference implementations */
+  namespace scalar
+  {
+    MisfitSums norms(double const* in, int n);
+    MisfitSums linear(double const* in, double const* y_dif2,
+        double const* y_dif, double const* y, int n, double a1, double a2);
+    MisfitSums nonlinear(double const* in, double const* y_dif2,
+        double const* y_dif, double const* y, double const* y_square,
+        double const* y_cube, int n, double a1, double a2, double c0,
+        double c1);
+    MisfitSums norms(float const* in, int n);
+    MisfitSums linear(float const* in, float const* y_dif2,
+        float const* y_dif, float const* y, int n, double a1, double a2);
+    MisfitSums nonlinear(float const* in, float const* y_dif2,
+        float const* y_dif, float const* y, float const* y_square,
+        float const* y_cube, int n, double a1, double a2, double c0,
+        double c1);
+  } // namespace scalar
+
+} // namespace kernel
+
+#endif // include guard
+
+/* ----- END OF kernel.h  ----- */
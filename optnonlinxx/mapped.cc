@@ -0,0 +1,118 @@
+/*! \file mapped.cc
+ * \brief Implementation of memory mapped time series.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Implementation of memory mapped time series.
+ *
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  Provide MappedFile and viewSeries.
+ *
+ * ============================================================================
+ */
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <aff/series.h>
+#include "mapped.h"
+
+/* -------------------------------------------------------------------------- */
+MappedFile::MappedFile(std::string const& filename) : Mdata(0), Msize(0)
+{
+  int const fd = open(filename.c_str(), O_RDONLY);
+  if (-1 == fd)
+  {
+    throw std::string("Cannot open input file '"+filename+"'.");
+  }
+  struct stat st;
+  if (-1 == fstat(fd, &st))
+  {
+    close(fd);
+    throw std::string("Cannot stat input file '"+filename+"'.");
+  }
+  Msize = st.st_size;
+  if (0 == Msize)
+  {
+    close(fd);
+    throw std::string("Input file '"+filename+"' is empty.");
+  }
+  void* addr = mmap(0, Msize, PROT_READ, MAP_PRIVATE, fd, 0);
+  // the mapping persists after the file descriptor was closed
+  close(fd);
+  if (MAP_FAILED == addr)
+  {
+    throw std::string("Cannot map input file '"+filename+"'.");
+  }
+  // the samples are streamed through by the kernels
+  madvise(addr, Msize, MADV_SEQUENTIAL);
+  Mdata = static_cast<char const*>(addr);
+} // MappedFile::MappedFile
+
+/* -------------------------------------------------------------------------- */
+MappedFile::~MappedFile()
+{
+  munmap(const_cast<char*>(Mdata), Msize);
+} // MappedFile::~MappedFile
+
+/* -------------------------------------------------------------------------- */
+datrw::Tdseries viewSeries(double const* samples, size_t n)
+{
+  // the shared heap does not take ownership of external memory; the samples
+  // are never written since the series are only read by the application
+  aff::SharedHeap<double> heap(const_cast<double*>(samples), n);
+  return datrw::Tdseries(aff::LinearShape(0, n-1, 0), heap);
+} // function viewSeries
+
+/* -------------------------------------------------------------------------- */
+MappedSeries::MappedSeries(std::string const& filename) : Mfile(filename)
+{
+  if (0 != Mfile.size() % sizeof(double))
+  {
+    throw std::string("Size of raw input file '"+filename+
+        "' is not a multiple of the sample size.");
+  }
+} // MappedSeries::MappedSeries
+
+/* -------------------------------------------------------------------------- */
+datrw::Tdseries MappedSeries::series() const
+{
+  return viewSeries(reinterpret_cast<double const*>(Mfile.data()), size());
+} // function MappedSeries::series
+
+/* -------------------------------------------------------------------------- */
+sff::WID2 MappedSeries::wid2(double dt) const
+{
+  sff::WID2 retval;
+  retval.nsamples = size();
+  retval.dt = dt;
+  return retval;
+} // function MappedSeries::wid2
+
+/* ----- END OF mapped.cc  ----- */
@@ -0,0 +1,128 @@
+/*! \file mapped.h
+ * \brief Declaration of memory mapped time series.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Declaration of memory mapped time series. Files of the raw input
+ * format consist of the samples only (IEEE double precision values in the
+ * byte order of the host). They are mapped into memory read-only and the
+ * samples are exposed as a time series without copying them.
+ *
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  Provide MappedFile and viewSeries.
+ *
+ * ============================================================================
+ */
+
+#include <string>
+#include <cstddef>
+#include <datrwxx/types.h>
+#include <sffxx.h>
+
+#ifndef _OPTNONLIN_MAPPED_H_
+#define _OPTNONLIN_MAPPED_H_
+
+/*!
+ * file mapped into memory read-only
+ */
+class MappedFile
+{
+  public:
+    /*!
+     * constructor
+     *
+     * \param filename path of the file to map
+     */
+    MappedFile(std::string const& filename);
+    //! destructor
+    ~MappedFile();
+    //! first byte of the file
+    char const* data() const { return Mdata; }
+    //! size of the file in bytes
+    size_t size() const { return Msize; }
+
+  private:
+    MappedFile(MappedFile const&);
+    MappedFile& operator=(MappedFile const&);
+
+    //! mapped bytes
+    char const* Mdata;
+    //! size of the mapping in bytes
+    size_t Msize;
+
+}; // class MappedFile
+
+/*!
+ * read-only time series referring to external samples
+ *
+ * The samples must not be modified through the series and must outlive
+ * it.
+ *
+ * \param samples first sample
+ * \param n number of samples
+ */
+datrw::Tdseries viewSeries(double const* samples, size_t n);
+
+/*!
+ * time series file of the raw input format mapped into memory
+ *
+ * The series returned by series() refers to the mapped samples. It must not
+ * be modified and must not be used after the object was destroyed.
+ */
+class MappedSeries
+{
+  public:
+    /*!
+     * constructor
+     *
+     * \param filename path of the file to map
+     */
+    MappedSeries(std::string const& filename);
+    //! number of samples
+    size_t size() const { return Mfile.size()/sizeof(double); }
+    //! read-only view of the samples
+    datrw::Tdseries series() const;
+    /*!
+     * header of the series
+     *
+     * \param dt sampling interval (not contained in raw files)
+     */
+    sff::WID2 wid2(double dt) const;
+
+  private:
+    MappedSeries(MappedSeries const&);
+    MappedSeries& operator=(MappedSeries const&);
+
+    //! mapped file
+    MappedFile Mfile;
+
+}; // class MappedSeries
+
+#endif // include guard
+
+/* ----- END OF mapped.h  ----- */
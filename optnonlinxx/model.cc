@@ -0,0 +1,250 @@
+/*! \file model.cc
+ * \brief Registry of the seismometer models selectable at runtime.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Registry of the seismometer models selectable at runtime. To
+ * provide a new model add a typedef to model.h, an entry to the registry
+ * below and explicit instantiations of ModelApplication to visitor.cc.
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  Fused preparation of derivatives and regressors.
+ * 16/10/2026  V0.3  Selectable derivative operators.
+ * 16/10/2026  V0.4  Regressors are stored in a FeatureMatrix.
+ *
+ * ============================================================================
+ */
+
+#include "model.h"
+#include "visitor.h"
+
+namespace model
+{
+
+  namespace
+  {
+    //! type of the visitors created
+    typedef opt::ParameterSpaceVisitor<TcoordType, TresultType> Tvisitor;
+
+    //! create the visitor of a model
+    template <typename TModel, typename Tvalue>
+    Tvisitor* create(aff::Series<Tvalue> const& calib_in_series,
+        aff::Series<Tvalue> const& y_dif2, aff::Series<Tvalue> const& y_dif,
+        aff::Series<Tvalue> const& y,
+        std::vector<aff::Series<Tvalue> > const& features,
+        CoordinateMap const& coordinates, bool verbose)
+    {
+      return new ModelApplication<TModel, Tvalue>(calib_in_series, y_dif2,
+          y_dif, y, coordinates, verbose);
+    }
+
+    // the linear and the cubic model use the hand-written kernels
+    template <>
+    Tvisitor* create<LinearModel, double>(
+        datrw::Tdseries const& calib_in_series,
+        datrw::Tdseries const& y_dif2, datrw::Tdseries const& y_dif,
+        datrw::Tdseries const& y,
+        std::vector<datrw::Tdseries> const& features,
+        CoordinateMap const& coordinates, bool verbose)
+    {
+      return new BasicLinApplication<double>(calib_in_series, y_dif2, y_dif,
+          y, coordinates, verbose);
+    }
+
+    template <>
+    Tvisitor* create<LinearModel, float>(
+        datrw::Tfseries const& calib_in_series,
+        datrw::Tfseries const& y_dif2, datrw::Tfseries const& y_dif,
+        datrw::Tfseries const& y,
+        std::vector<datrw::Tfseries> const& features,
+        CoordinateMap const& coordinates, bool verbose)
+    {
+      return new BasicLinApplication<float>(calib_in_series, y_dif2, y_dif,
+          y, coordinates, verbose);
+    }
+
+    template <>
+    Tvisitor* create<CubicModel, double>(
+        datrw::Tdseries const& calib_in_series,
+        datrw::Tdseries const& y_dif2, datrw::Tdseries const& y_dif,
+        datrw::Tdseries const& y,
+        std::vector<datrw::Tdseries> const& features,
+        CoordinateMap const& coordinates, bool verbose)
+    {
+      return new BasicNonLinApplication<double>(calib_in_series, y_dif2,
+          y_dif, y, features.at(0), features.at(1), coordinates, verbose);
+    }
+
+    template <>
+    Tvisitor* create<CubicModel, float>(
+        datrw::Tfseries const& calib_in_series,
+        datrw::Tfseries const& y_dif2, datrw::Tfseries const& y_dif,
+        datrw::Tfseries const& y,
+        std::vector<datrw::Tfseries> const& features,
+        CoordinateMap const& coordinates, bool verbose)
+    {
+      return new BasicNonLinApplication<float>(calib_in_series, y_dif2,
+          y_dif, y, features.at(0), features.at(1), coordinates, verbose);
+    }
+
+    //! signature of the visitor factories
+    template <typename Tvalue>
+    struct Factory
+    {
+      typedef aff::Series<Tvalue> Tseries;
+      typedef Tvisitor* (*Type)(Tseries const&, Tseries const&,
+          Tseries const&, Tseries const&, std::vector<Tseries> const&,
+          CoordinateMap const&, bool);
+    }; // struct Factory
+
+    //! entry of the model registry
+    struct Entry
+    {
+      char const* name;
+      std::vector<std::string> (*terms)();
+      void (*prepare)(datrw::Tdseries const&, FeatureMatrix&);
+      void (*prepareFused)(datrw::Tdseries const&, double,
+          DerivativeOperator const&, FeatureMatrix&, size_t);
+      Factory<double>::Type createDouble;
+      Factory<float>::Type createFloat;
+    }; // struct Entry
+
+#define OPTNONLIN_MODEL(name, TModel) \
+    { name, TModel::terms, TModel::prepare, TModel::prepareFused, \
+      create<TModel, double>, \
+      create<TModel, float> }
+
+    //! registry of the models selectable at runtime
+    Entry const registry[] =
+    {
+      OPTNONLIN_MODEL("linear", LinearModel),
+      OPTNONLIN_MODEL("cubic", CubicModel),
+      OPTNONLIN_MODEL("quadratic-damping", QuadraticDampingModel),
+      OPTNONLIN_MODEL("odd", OddModel),
+      OPTNONLIN_MODEL("product", ProductModel)
+    };
+
+#undef OPTNONLIN_MODEL
+
+    //! look up a model in the registry
+    Entry const& lookup(std::string const& name)
+    {
+      for (size_t i=0; i<sizeof(registry)/sizeof(registry[0]); ++i)
+      {
+        if (name == registry[i].name) { return registry[i]; }
+      }
+      throw std::string("Unknown model '"+name+"'.");
+    }
+
+    //! select the factory of the sample type
+    inline Factory<double>::Type factory(Entry const& entry, double)
+    {
+      return entry.createDouble;
+    }
+
+    inline Factory<float>::Type factory(Entry const& entry, float)
+    {
+      return entry.createFloat;
+    }
+  } // namespace (unnamed)
+
+  /* ----------------------------------------------------------------------- */
+  std::vector<std::string> names()
+  {
+    std::vector<std::string> retval;
+    for (size_t i=0; i<sizeof(registry)/sizeof(registry[0]); ++i)
+    {
+      retval.push_back(registry[i].name);
+    }
+    return retval;
+  } // function names
+
+  /* ----------------------------------------------------------------------- */
+  std::vector<std::string> terms(std::string const& name)
+  {
+    return lookup(name).terms();
+  } // function terms
+
+  /* ----------------------------------------------------------------------- */
+  void prepare(std::string const& name, datrw::Tdseries const& y,
+      FeatureMatrix& matrix)
+  {
+    lookup(name).prepare(y, matrix);
+  } // function prepare
+
+  /* ----------------------------------------------------------------------- */
+  void prepareFused(std::string const& name, datrw::Tdseries const& y,
+      double dt, DerivativeOperator const& op, FeatureMatrix& matrix,
+      size_t num_threads)
+  {
+    lookup(name).prepareFused(y, dt, op, matrix, num_threads);
+  } // function prepareFused
+
+  /* ----------------------------------------------------------------------- */
+  template <typename Tvalue>
+  opt::ParameterSpaceVisitor<TcoordType, TresultType>* createApplication(
+      std::string const& name, aff::Series<Tvalue> const& calib_in_series,
+      aff::Series<Tvalue> const& y_dif2, aff::Series<Tvalue> const& y_dif,
+      aff::Series<Tvalue> const& y,
+      std::vector<aff::Series<Tvalue> > const& features,
+      CoordinateMap const& coordinates, bool verbose)
+  {
+    Entry const& entry = lookup(name);
+    if (features.size() != entry.terms().size())
+    {
+      throw std::string("Inconsistent number of regressors.");
+    }
+    return factory(entry, Tvalue())(calib_in_series, y_dif2, y_dif, y,
+        features, coordinates, verbose);
+  } // function createApplication
+
+  template opt::ParameterSpaceVisitor<TcoordType, TresultType>*
+    createApplication<double>(std::string const&, datrw::Tdseries const&,
+        datrw::Tdseries const&, datrw::Tdseries const&,
+        datrw::Tdseries const&, std::vector<datrw::Tdseries> const&,
+        CoordinateMap const&, bool);
+  template opt::ParameterSpaceVisitor<TcoordType, TresultType>*
+    createApplication<float>(std::string const&, datrw::Tfseries const&,
+        datrw::Tfseries const&, datrw::Tfseries const&,
+        datrw::Tfseries const&, std::vector<datrw::Tfseries> const&,
+        CoordinateMap const&, bool);
+
+  /* ----------------------------------------------------------------------- */
+  opt::ParameterSpaceVisitor<TcoordType, TresultType>* createApplication(
+      std::string const& name, datrw::Tdseries const& calib_in_series,
+      FeatureMatrix const& matrix, datrw::Tdseries const& y,
+      CoordinateMap const& coordinates, bool verbose)
+  {
+    return createApplication(name, calib_in_series,
+        matrix.series(FeatureMatrix::dif2Column),
+        matrix.series(FeatureMatrix::difColumn), y, matrix.features(),
+        coordinates, verbose);
+  } // function createApplication
+
+} // namespace model
+
+/* ----- END OF model.cc  ----- */
@@ -0,0 +1,423 @@
+/*! \file model.h
+ * \brief Compile time description of the seismometer models of optnonlin.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Compile time description of the seismometer models of optnonlin.
+ * Every model consists of the linear part
+ *
+ *   y''+a1*y'+a2*y-a''
+ *
+ * plus a list of nonlinear terms, each multiplied by an unknown coefficient
+ * (c0, c1, ...). A model is a typelist of terms:
+ *
+ *   typedef model::Model<model::Power<2>, model::Power<3> > CubicModel;
+ *
+ * The misfit kernel of a model is generated from the typelist, so the terms
+ * are evaluated inline on the fly and a model pays for its own terms only.
+ *
+ * The models selectable at runtime are listed in model.cc.
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  Fused preparation of derivatives and regressors.
+ * 16/10/2026  V0.3  Selectable derivative operators.
+ * 16/10/2026  V0.4  Regressors are stored in a FeatureMatrix.
+ *
+ * ============================================================================
+ */
+
+#include <cmath>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <datrwxx/types.h>
+#include <optimizexx/application.h>
+#include "types.h"
+#include "kernel.h"
+#include "util.h"
+#include "prepare.h"
+#include "featurematrix.h"
+#include "coordinates.h"
+
+#ifndef _OPTNONLIN_MODEL_H_
+#define _OPTNONLIN_MODEL_H_
+
+namespace opt = optimize;
+
+namespace model
+{
+  /* ----------------------------------------------------------------------- */
+  // nonlinear terms
+
+  //! term \f$y^K\f$
+  template <int K>
+  struct Power
+  {
+    static std::string name()
+    {
+      std::ostringstream oss;
+      oss << "y^" << K;
+      return oss.str();
+    }
+    template <typename Tvalue>
+    static Tvalue eval(Tvalue y, Tvalue y_dif)
+    {
+      return Power<K-1>::eval(y, y_dif)*y;
+    }
+    static void prepare(datrw::Tdseries const& y,
+        datrw::Tdseries const& y_dif, datrw::Tdseries& result)
+    {
+      for (int j=y.f(); j<=y.l(); ++j) { result(j) = pow(y(j), double(K)); }
+    }
+  }; // struct Power
+
+  template <>
+  struct Power<1>
+  {
+    static std::string name() { return "y"; }
+    template <typename Tvalue>
+    static Tvalue eval(Tvalue y, Tvalue y_dif) { return y; }
+    static void prepare(datrw::Tdseries const& y,
+        datrw::Tdseries const& y_dif, datrw::Tdseries& result)
+    {
+      util::multiply(y, result, 1.);
+    }
+  }; // struct Power<1>
+
+  // the features of the original nonlinear model are computed as before
+  template <>
+  inline void Power<2>::prepare(datrw::Tdseries const& y,
+      datrw::Tdseries const& y_dif, datrw::Tdseries& result)
+  {
+    util::square(y, result);
+  }
+
+  template <>
+  inline void Power<3>::prepare(datrw::Tdseries const& y,
+      datrw::Tdseries const& y_dif, datrw::Tdseries& result)
+  {
+    util::cube(y, result);
+  }
+
+  //! term \f$|y|\cdot y\f$ (quadratic term of odd symmetry)
+  struct AbsProduct
+  {
+    static std::string name() { return "|y|*y"; }
+    template <typename Tvalue>
+    static Tvalue eval(Tvalue y, Tvalue y_dif) { return std::abs(y)*y; }
+    static void prepare(datrw::Tdseries const& y,
+        datrw::Tdseries const& y_dif, datrw::Tdseries& result)
+    {
+      for (int j=y.f(); j<=y.l(); ++j) { result(j) = eval(y(j), y_dif(j)); }
+    }
+  }; // struct AbsProduct
+
+  //! term \f$\dot{y}\cdot|\dot{y}|\f$ (quadratic damping)
+  struct QuadraticDamping
+  {
+    static std::string name() { return "y'*|y'|"; }
+    template <typename Tvalue>
+    static Tvalue eval(Tvalue y, Tvalue y_dif)
+    {
+      return y_dif*std::abs(y_dif);
+    }
+    static void prepare(datrw::Tdseries const& y,
+        datrw::Tdseries const& y_dif, datrw::Tdseries& result)
+    {
+      for (int j=y.f(); j<=y.l(); ++j) { result(j) = eval(y(j), y_dif(j)); }
+    }
+  }; // struct QuadraticDamping
+
+  //! term \f$y\cdot\dot{y}\f$ (displacement dependent damping)
+  struct Product
+  {
+    static std::string name() { return "y*y'"; }
+    template <typename Tvalue>
+    static Tvalue eval(Tvalue y, Tvalue y_dif) { return y*y_dif; }
+    static void prepare(datrw::Tdseries const& y,
+        datrw::Tdseries const& y_dif, datrw::Tdseries& result)
+    {
+      for (int j=y.f(); j<=y.l(); ++j) { result(j) = eval(y(j), y_dif(j)); }
+    }
+  }; // struct Product
+
+  /* ----------------------------------------------------------------------- */
+  //! recursion over the terms of a typelist
+  template <typename... Terms>
+  struct TermList
+  {
+    static int const size = 0;
+    template <typename Tvalue>
+    static Tvalue sum(Tvalue y, Tvalue y_dif, Tvalue const* c) { return 0; }
+    static void names(std::vector<std::string>& names) { }
+    static void prepare(datrw::Tdseries const& y,
+        datrw::Tdseries const& y_dif, datrw::Tdseries* features) { }
+    static void store(double y, double y_dif, double* const* features,
+        int j) { }
+  }; // struct TermList
+
+  template <typename Head, typename... Tail>
+  struct TermList<Head, Tail...>
+  {
+    static int const size = 1+TermList<Tail...>::size;
+    //! sum of the terms weighted with their coefficients
+    template <typename Tvalue>
+    static Tvalue sum(Tvalue y, Tvalue y_dif, Tvalue const* c)
+    {
+      return c[0]*Head::eval(y, y_dif)+TermList<Tail...>::sum(y, y_dif, c+1);
+    }
+    static void names(std::vector<std::string>& names)
+    {
+      names.push_back(Head::name());
+      TermList<Tail...>::names(names);
+    }
+    static void prepare(datrw::Tdseries const& y,
+        datrw::Tdseries const& y_dif, datrw::Tdseries* features)
+    {
+      Head::prepare(y, y_dif, features[0]);
+      TermList<Tail...>::prepare(y, y_dif, features+1);
+    }
+    //! store the terms of sample \a j
+    static void store(double y, double y_dif, double* const* features,
+        int j)
+    {
+      features[0][j] = Head::eval(y, y_dif);
+      TermList<Tail...>::store(y, y_dif, features+1, j);
+    }
+  }; // struct TermList
+
+  /* ----------------------------------------------------------------------- */
+  //! id of the unknown parameter which is the coefficient of term \a index
+  inline std::string coefficientId(int index)
+  {
+    std::ostringstream oss;
+    oss << "c" << index;
+    return oss.str();
+  }
+
+  /*!
+   * seismometer model consisting of the linear part and the nonlinear terms
+   * \a Terms
+   */
+  template <typename... Terms>
+  struct Model
+  {
+    //! number of nonlinear terms
+    static int const size = TermList<Terms...>::size;
+    //! number of independent accumulators of the misfit kernel
+    static int const lanes = 4;
+
+    //! names of the nonlinear terms
+    static std::vector<std::string> terms()
+    {
+      std::vector<std::string> names;
+      TermList<Terms...>::names(names);
+      return names;
+    }
+
+    //! check the shape of a feature matrix
+    static void check(datrw::Tdseries const& y, FeatureMatrix const& matrix)
+    {
+      if (size_t(y.size()) != matrix.size() ||
+          FeatureMatrix::featureColumn+size != matrix.count())
+      {
+        throw std::string("Inconsistent feature matrix.");
+      }
+    }
+
+    /*!
+     * compute the regressor time series of the nonlinear terms
+     *
+     * \param y output time series of the seismometer
+     * \param matrix holds the derivative of the output time series and
+     * receives the \a size regressors
+     */
+    static void prepare(datrw::Tdseries const& y, FeatureMatrix& matrix)
+    {
+      check(y, matrix);
+      std::vector<datrw::Tdseries> features(matrix.features());
+      TermList<Terms...>::prepare(y,
+          matrix.series(FeatureMatrix::difColumn), features.data());
+    }
+
+    /*!
+     * compute the derivatives and the regressors of the nonlinear terms in
+     * a single multithreaded pass (see prepare::fused())
+     *
+     * The terms are evaluated by their eval() function, thus powers are
+     * computed by multiplication instead of \c pow().
+     *
+     * \param y output time series of the seismometer
+     * \param dt sampling interval
+     * \param op derivative operator
+     * \param matrix receives the derivatives and the \a size regressors
+     * \param num_threads number of threads
+     */
+    static void prepareFused(datrw::Tdseries const& y, double dt,
+        DerivativeOperator const& op, FeatureMatrix& matrix,
+        size_t num_threads)
+    {
+      check(y, matrix);
+      double* pointers[size+1];
+      for (int i=0; i<size; ++i)
+      {
+        pointers[i] = matrix.column(FeatureMatrix::featureColumn+i);
+      }
+      prepare::fused<TermList<Terms...> >(kernel::samples(y), y.size(), dt,
+          op, matrix.column(FeatureMatrix::dif2Column),
+          matrix.column(FeatureMatrix::difColumn), pointers, num_threads);
+    }
+
+    /*!
+     * sums of the absolute and squared residual of a parameter
+     * configuration
+     *
+     * The terms are evaluated from \a y and \a y_dif on the fly. Independent
+     * accumulators allow the compiler to vectorize the loop.
+     *
+     * \param c \a size coefficients of the nonlinear terms
+     */
+    template <typename Tvalue>
+    static kernel::MisfitSums misfit(Tvalue const* in, Tvalue const* y_dif2,
+        Tvalue const* y_dif, Tvalue const* y, int n, double a1, double a2,
+        double const* c)
+    {
+      Tvalue const ta1 = a1;
+      Tvalue const ta2 = a2;
+      Tvalue tc[size+1];
+      for (int i=0; i<size; ++i) { tc[i] = c[i]; }
+      double md[lanes] = { 0 };
+      double rms[lanes] = { 0 };
+      int j = 0;
+      for (; j+lanes<=n; j+=lanes)
+      {
+        for (int l=0; l<lanes; ++l)
+        {
+          double const r = std::abs(y_dif2[j+l] + ta1*y_dif[j+l] +
+              ta2*y[j+l] + TermList<Terms...>::sum(y[j+l], y_dif[j+l], tc) -
+              in[j+l]);
+          md[l] += r;
+          rms[l] += r*r;
+        }
+      }
+      for (; j<n; ++j)
+      {
+        double const r = std::abs(y_dif2[j] + ta1*y_dif[j] + ta2*y[j] +
+            TermList<Terms...>::sum(y[j], y_dif[j], tc) - in[j]);
+        md[0] += r;
+        rms[0] += r*r;
+      }
+      kernel::MisfitSums sums;
+      for (int l=0; l<lanes; ++l)
+      {
+        sums.md += md[l];
+        sums.rms += rms[l];
+      }
+      return sums;
+    }
+  }; // struct Model
+
+  /* ----------------------------------------------------------------------- */
+  // models selectable at runtime
+
+  //! linear model
+  typedef Model<> LinearModel;
+  //! nonlinear model with quadratic and cubic stiffness
+  typedef Model<Power<2>, Power<3> > CubicModel;
+  //! quadratic damping
+  typedef Model<QuadraticDamping> QuadraticDampingModel;
+  //! stiffness of odd symmetry
+  typedef Model<AbsProduct, Power<3> > OddModel;
+  //! displacement dependent damping
+  typedef Model<Product> ProductModel;
+
+  /* ----------------------------------------------------------------------- */
+  //! names of the models selectable at runtime
+  std::vector<std::string> names();
+
+  /*!
+   * names of the nonlinear terms of a model
+   *
+   * The coefficient of term \c i is the unknown parameter
+   * coefficientId(i). Throws if \a name is not a known model.
+   */
+  std::vector<std::string> terms(std::string const& name);
+
+  /*!
+   * compute the regressor time series of the nonlinear terms of a model
+   *
+   * \param matrix holds the derivatives and receives the regressors; it
+   * must have FeatureMatrix::featureColumn+terms(name).size() columns
+   */
+  void prepare(std::string const& name, datrw::Tdseries const& y,
+      FeatureMatrix& matrix);
+
+  /*!
+   * compute the derivatives and the regressor time series of the nonlinear
+   * terms of a model in a single pass
+   *
+   * Replaces util::dif2(), util::dif() resp. DerivativeOperator::apply()
+   * and prepare().
+   */
+  void prepareFused(std::string const& name, datrw::Tdseries const& y,
+      double dt, DerivativeOperator const& op, FeatureMatrix& matrix,
+      size_t num_threads);
+
+  /*!
+   * create the visitor computing the misfit of a model from the time series
+   *
+   * Models with hand-written vectorized kernels use them. Instantiated for
+   * \c float and \c double.
+   *
+   * \param features regressor time series of the nonlinear terms as returned
+   * by prepare() (converted to \a Tvalue)
+   * \param coordinates coordinate indices of the unknown parameters
+   */
+  template <typename Tvalue>
+  opt::ParameterSpaceVisitor<TcoordType, TresultType>* createApplication(
+      std::string const& name, aff::Series<Tvalue> const& calib_in_series,
+      aff::Series<Tvalue> const& y_dif2, aff::Series<Tvalue> const& y_dif,
+      aff::Series<Tvalue> const& y,
+      std::vector<aff::Series<Tvalue> > const& features,
+      CoordinateMap const& coordinates, bool verbose=false);
+
+  /*!
+   * create the visitor computing the misfit of a model from the time series
+   * of a feature matrix
+   *
+   * The visitor reads the columns of \a matrix in place.
+   */
+  opt::ParameterSpaceVisitor<TcoordType, TresultType>* createApplication(
+      std::string const& name, datrw::Tdseries const& calib_in_series,
+      FeatureMatrix const& matrix, datrw::Tdseries const& y,
+      CoordinateMap const& coordinates, bool verbose=false);
+
+} // namespace model
+
+#endif // include guard
+
+/* ----- END OF model.h  ----- */
@@ -0,0 +1,226 @@
+/*! \file polish.cc
+ * \brief Implementation of the local Levenberg-Marquardt polish of grid
+ * nodes.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Implementation of the local Levenberg-Marquardt polish of grid
+ * nodes.
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <cmath>
+#include <string>
+#include <algorithm>
+#include "polish.h"
+#include "kernel.h"
+
+namespace
+{
+  /*!
+   * solve the linear system \f$Ax=b\f$ by Gaussian elimination with partial
+   * pivoting
+   *
+   * \return false if the matrix is singular
+   */
+  bool solve(std::vector<double> a, std::vector<double> b,
+      std::vector<double>& x)
+  {
+    int const m = b.size();
+    for (int k=0; k<m; ++k)
+    {
+      int pivot = k;
+      for (int i=k+1; i<m; ++i)
+      {
+        if (fabs(a[i*m+k]) > fabs(a[pivot*m+k])) { pivot = i; }
+      }
+      if (0. == a[pivot*m+k]) { return false; }
+      for (int j=0; j<m; ++j) { std::swap(a[k*m+j], a[pivot*m+j]); }
+      std::swap(b[k], b[pivot]);
+      for (int i=k+1; i<m; ++i)
+      {
+        double const factor = a[i*m+k]/a[k*m+k];
+        for (int j=k; j<m; ++j) { a[i*m+j] -= factor*a[k*m+j]; }
+        b[i] -= factor*b[k];
+      }
+    }
+    x.assign(m, 0.);
+    for (int k=m-1; k>=0; --k)
+    {
+      double sum = b[k];
+      for (int j=k+1; j<m; ++j) { sum -= a[k*m+j]*x[j]; }
+      x[k] = sum/a[k*m+k];
+    }
+    return true;
+  } // function solve
+} // namespace (unnamed)
+
+/* -------------------------------------------------------------------------- */
+LevenbergMarquardt::LevenbergMarquardt(GramMatrix const& gram,
+    std::vector<double const*> const& columns, int n, bool gain,
+    int max_iterations, double tolerance) :
+  Mgram(gram), Mcolumns(columns), Mn(n), Mgain(gain),
+  MmaxIterations(max_iterations), Mtolerance(tolerance), Mpi(4.*atan(1.))
+{
+  if (4 > Mgram.size() || Mgram.size() != int(Mcolumns.size()))
+  {
+    throw std::string("Inconsistent number of regressors.");
+  }
+} // constructor LevenbergMarquardt
+
+/* -------------------------------------------------------------------------- */
+void LevenbergMarquardt::coefficients(std::vector<double> const& theta,
+    double* x) const
+{
+  int const k = Mgram.size();
+  // h  -> theta[0]
+  // T0 -> theta[1]
+  x[0] = 1.;
+  x[1] = ((2*Mpi)/theta[1])*theta[0];
+  x[2] = (4.*pow(Mpi, 2.))/theta[1];
+  for (int i=3; i<k-1; ++i) { x[i] = theta[i-1]; }
+  x[k-1] = Mgain ? -theta[size()-1] : -1.;
+} // function LevenbergMarquardt::coefficients
+
+/* -------------------------------------------------------------------------- */
+void LevenbergMarquardt::derivatives(std::vector<double> const& theta,
+    double* d) const
+{
+  int const k = Mgram.size();
+  int const p = size();
+  std::fill(d, d+k*p, 0.);
+  d[1*p+0] = (2*Mpi)/theta[1];
+  d[1*p+1] = -((2*Mpi)/(theta[1]*theta[1]))*theta[0];
+  d[2*p+1] = -(4.*pow(Mpi, 2.))/(theta[1]*theta[1]);
+  for (int i=3; i<k-1; ++i) { d[i*p+i-1] = 1.; }
+  if (Mgain) { d[(k-1)*p+p-1] = -1.; }
+} // function LevenbergMarquardt::derivatives
+
+/* -------------------------------------------------------------------------- */
+double LevenbergMarquardt::md(double const* x) const
+{
+  int const k = Mgram.size();
+  double sum = 0;
+  for (int l=0; l<Mn; ++l)
+  {
+    double r = 0;
+    for (int i=0; i<k; ++i) { r += x[i]*Mcolumns[i][l]; }
+    sum += fabs(r);
+  }
+  return sum / kernel::norms(Mcolumns.back(), Mn).md;
+} // function LevenbergMarquardt::md
+
+/* -------------------------------------------------------------------------- */
+PolishResult LevenbergMarquardt::polish(std::vector<double> const& start) const
+{
+  int const k = Mgram.size();
+  int const p = size();
+  if (int(start.size()) != p)
+  {
+    throw std::string("Inconsistent number of parameters.");
+  }
+
+  PolishResult result;
+  result.parameters = start;
+  result.iterations = 0;
+  result.converged = false;
+  result.stalled = false;
+
+  std::vector<double> x(k), d(k*p), gd(k*p), a(p*p), b(p), step;
+  coefficients(result.parameters, &x[0]);
+  double sum = Mgram.quadraticForm(&x[0]);
+  double lambda = 1.e-3;
+  while (result.iterations < MmaxIterations && ! result.converged)
+  {
+    ++result.iterations;
+    // normal equations J^TJ = D^TGD and J^Tr = D^TGx
+    derivatives(result.parameters, &d[0]);
+    for (int i=0; i<k; ++i)
+    {
+      for (int j=0; j<p; ++j)
+      {
+        gd[i*p+j] = 0;
+        for (int l=0; l<k; ++l) { gd[i*p+j] += Mgram(i, l)*d[l*p+j]; }
+      }
+    }
+    for (int i=0; i<p; ++i)
+    {
+      b[i] = 0;
+      for (int l=0; l<k; ++l) { b[i] -= gd[l*p+i]*x[l]; }
+      for (int j=0; j<p; ++j)
+      {
+        a[i*p+j] = 0;
+        for (int l=0; l<k; ++l) { a[i*p+j] += d[l*p+i]*gd[l*p+j]; }
+      }
+    }
+
+    // increase damping until the sum of squares decreases
+    bool accepted = false;
+    while (! accepted && lambda < 1.e16)
+    {
+      std::vector<double> damped(a);
+      for (int i=0; i<p; ++i) { damped[i*p+i] *= 1.+lambda; }
+      std::vector<double> trial(result.parameters);
+      if (solve(damped, b, step))
+      {
+        for (int i=0; i<p; ++i) { trial[i] += step[i]; }
+      }
+      if (trial != result.parameters && 0 < trial[1])
+      {
+        std::vector<double> xt(k);
+        coefficients(trial, &xt[0]);
+        double const trialSum = Mgram.quadraticForm(&xt[0]);
+        if (trialSum < sum)
+        {
+          result.converged = (sum-trialSum) <= Mtolerance*sum;
+          result.parameters.swap(trial);
+          x.swap(xt);
+          sum = trialSum;
+          lambda /= 10.;
+          accepted = true;
+          continue;
+        }
+      }
+      lambda *= 10.;
+    }
+    // no further decrease possible; this is a stall, not convergence
+    if (! accepted)
+    {
+      result.stalled = true;
+      break;
+    }
+  }
+
+  result.rms = sqrt(sum / Mgram(k-1, k-1));
+  result.md = md(&x[0]);
+  return result;
+} // function LevenbergMarquardt::polish
+
+/* ----- END OF polish.cc  ----- */
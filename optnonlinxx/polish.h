@@ -0,0 +1,136 @@
+/*! \file polish.h
+ * \brief Declaration of the local Levenberg-Marquardt polish of grid nodes.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Declaration of the local Levenberg-Marquardt polish of grid nodes.
+ * The precision of a grid search is limited by the stepwidths of the grid.
+ * Starting from the best nodes the sum of the squared residual is minimized
+ * with respect to all unknown parameters with a derivative based local
+ * optimizer.
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <vector>
+#include "gram.h"
+
+#ifndef _OPTNONLIN_POLISH_H_
+#define _OPTNONLIN_POLISH_H_
+
+//! result of a local optimization
+struct PolishResult
+{
+  //! optimal parameters (h, T0, c0, ..., [gain])
+  std::vector<double> parameters;
+  //! MD misfit of the optimal parameters
+  double md;
+  //! RMS misfit of the optimal parameters
+  double rms;
+  //! number of iterations performed
+  int iterations;
+  //! flag if the iteration converged
+  bool converged;
+  /*!
+   * flag if the iteration stopped since no damping of the step decreased
+   * the sum of squares; the result then did not converge
+   */
+  bool stalled;
+}; // struct PolishResult
+
+/*!
+ * Levenberg-Marquardt minimization of the sum of the squared residual
+ * \f[
+ *    r = \ddot{y}+a_1\dot{y}+a_2y+\sum_i c_if_i-g\ddot{u}
+ * \f]
+ * with \f$a_1=\frac{2\pi}{T_0}h\f$ and \f$a_2=\frac{4\pi^2}{T_0}\f$.
+ *
+ * The residual is \f$r=Xx(\theta)\f$ with the regressor matrix \f$X\f$ and
+ * the coefficient vector \f$x\f$. Thus the Jacobian is \f$J=XD\f$ with
+ * \f$D=\partial x/\partial\theta\f$ known analytically and both
+ * \f$J^TJ=D^TGD\f$ and \f$J^Tr=D^TGx\f$ are computed from the Gram matrix
+ * \f$G\f$ without touching the time series.
+ */
+class LevenbergMarquardt
+{
+  public:
+    /*!
+     * constructor
+     *
+     * \param gram Gram matrix of the regressors in the order
+     * \f$\ddot{y}, \dot{y}, y, f_0, \ldots, f_{k-1}, \ddot{u}\f$
+     * \param columns pointers to the first sample of the regressors (used
+     * for the MD misfit only)
+     * \param n number of samples of the regressors
+     * \param gain flag if the gain \f$g\f$ is optimized (otherwise
+     * \f$g=1\f$)
+     * \param max_iterations maximum number of iterations
+     * \param tolerance relative decrease of the sum of squares below which
+     * the iteration is regarded as converged
+     */
+    LevenbergMarquardt(GramMatrix const& gram,
+        std::vector<double const*> const& columns, int n, bool gain,
+        int max_iterations=100, double tolerance=1.e-12);
+    //! number of parameters (h, T0, c0, ..., [gain])
+    int size() const { return Mgram.size()-(Mgain ? 1 : 2); }
+    /*!
+     * optimize starting from \a start
+     *
+     * \param start initial parameters (h, T0, c0, ..., [gain])
+     */
+    PolishResult polish(std::vector<double> const& start) const;
+
+  private:
+    //! coefficient vector of the regressors
+    void coefficients(std::vector<double> const& theta, double* x) const;
+    //! Jacobian of the coefficient vector (row-major, size() columns)
+    void derivatives(std::vector<double> const& theta, double* d) const;
+    //! MD misfit of a coefficient vector
+    double md(double const* x) const;
+
+    //! Gram matrix of the regressors
+    GramMatrix const& Mgram;
+    //! regressor time series
+    std::vector<double const*> Mcolumns;
+    //! number of samples
+    int Mn;
+    //! flag if the gain is optimized
+    bool Mgain;
+    //! maximum number of iterations
+    int MmaxIterations;
+    //! convergence tolerance
+    double Mtolerance;
+    // pi constant
+    double const Mpi;
+
+}; // class LevenbergMarquardt
+
+#endif // include guard
+
+/* ----- END OF polish.h  ----- */
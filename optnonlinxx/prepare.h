@@ -0,0 +1,214 @@
+/*! \file prepare.h
+ * \brief Fused preparation of the derivatives and regressors.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Fused preparation of the derivatives and regressors. The
+ * derivatives of the output signal and the regressors of the nonlinear
+ * terms are computed within a single pass over the samples instead of one
+ * pass per series. The samples are split into contiguous chunks processed
+ * by several threads. The loop is free of dependencies between iterations
+ * so the compiler vectorizes it.
+ *
+ * The functions util::dif(), util::dif2() and the prepare() functions of
+ * the terms remain the reference implementation.
+ *
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  Selectable derivative operators.
+ * 16/10/2026  V0.2.1 Chunks of the threads start at cache line boundaries.
+ *
+ * ============================================================================
+ */
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+#include <boost/function.hpp>
+#include "derivative.h"
+
+#ifndef _OPTNONLIN_PREPARE_H_
+#define _OPTNONLIN_PREPARE_H_
+
+namespace prepare
+{
+  //! minimum number of samples of a chunk processed by a thread
+  size_t const minChunk = 1 << 16;
+  //! number of samples of a block convolved at once by interiorFir()
+  int const firBlock = 1024;
+
+  /*!
+   * compute the derivatives and the regressors of the interior samples
+   * \f$[begin, end)\f$
+   *
+   * The difference quotients are evaluated as in util::dif2() and
+   * util::dif(), so the derivatives are identical to the reference.
+   */
+  template <typename Tterms>
+  void interior(double const* y, int begin, int end, double dt,
+      double* y_dif2, double* y_dif, double* const* features)
+  {
+    double const dif_denominator = 2.*dt;
+    double const dif2_denominator = pow(dt, 2.);
+#pragma GCC ivdep
+    for (int j=begin; j<end; ++j)
+    {
+      double const d = (y[j+1]-y[j-1]) / dif_denominator;
+      y_dif2[j] = (y[j+1]-2*y[j]+y[j-1]) / dif2_denominator;
+      y_dif[j] = d;
+      Tterms::store(y[j], d, features, j);
+    }
+  } // function interior
+
+  /*!
+   * compute the derivatives and the regressors of the interior samples
+   * \f$[begin, end)\f$ with the FIR filters of a derivative operator
+   *
+   * The filters are applied to blocks of firBlock samples one coefficient
+   * at a time, thus the innermost loops run over contiguous samples and
+   * are vectorized while the block stays in the L1 cache.
+   *
+   * \param c1 coefficients of the first derivative divided by \a dt
+   * \param c2 coefficients of the second derivative divided by \a dt^2
+   * \param m half width of the filters
+   */
+  template <typename Tterms>
+  void interiorFir(double const* y, int begin, int end, double const* c1,
+      double const* c2, int m, double* y_dif2, double* y_dif,
+      double* const* features)
+  {
+    for (int block=begin; block<end; block+=firBlock)
+    {
+      int const block_end = std::min(block+firBlock, end);
+      double* const d1 = y_dif+block;
+      double* const d2 = y_dif2+block;
+      int const size = block_end-block;
+      std::fill(d1, d1+size, 0.);
+      std::fill(d2, d2+size, 0.);
+      for (int k=-m; k<=m; ++k)
+      {
+        double const a = c1[k+m];
+        double const b = c2[k+m];
+        double const* const s = y+block+k;
+#pragma GCC ivdep
+        for (int j=0; j<size; ++j)
+        {
+          d1[j] += a*s[j];
+          d2[j] += b*s[j];
+        }
+      }
+      for (int j=block; j<block_end; ++j)
+      {
+        Tterms::store(y[j], y_dif[j], features, j);
+      }
+    }
+  } // function interiorFir
+
+  /*!
+   * compute the derivatives and the regressors of a time series in a
+   * single pass
+   *
+   * The samples closer than the half width \f$m\f$ of the derivative
+   * operator to the ends take the derivatives of their nearest interior
+   * sample like in the reference implementation; the regressors of these
+   * samples are computed from the copied derivatives. The 3-point central
+   * difference is evaluated by interior(), all other operators by
+   * interiorFir().
+   *
+   * \tparam Tterms list of terms providing
+   * \c store(y, y_dif, features, j)
+   * \param y output time series of the seismometer
+   * \param n number of samples (at least \f$2m+1\f$)
+   * \param dt sampling interval
+   * \param op derivative operator
+   * \param y_dif2 receives the second derivative
+   * \param y_dif receives the derivative
+   * \param features pointers to the regressors of the terms
+   * \param num_threads number of threads
+   */
+  template <typename Tterms>
+  void fused(double const* y, int n, double dt,
+      DerivativeOperator const& op, double* y_dif2, double* y_dif,
+      double* const* features, size_t num_threads)
+  {
+    int const m = op.halfWidth();
+    if (2*m+1 > n) { throw std::string("Time series too short."); }
+
+    // filter coefficients scaled to the sampling interval
+    std::vector<double> c1(op.first());
+    std::vector<double> c2(op.second());
+    for (size_t k=0; k<c1.size(); ++k)
+    {
+      c1[k] /= dt;
+      c2[k] /= dt*dt;
+    }
+
+    // interior samples [m, n-m); the chunk boundaries are multiples of eight
+    // samples, i.e. cache lines of 64 byte aligned columns, so no two threads
+    // write to the same cache line
+    size_t const interior_size = n-2*m;
+    num_threads = std::max(size_t(1),
+        std::min(num_threads, interior_size/minChunk));
+    size_t const chunk = ((n-m+num_threads-1)/num_threads+7) & ~size_t(7);
+    boost::thread_group threads;
+    for (size_t begin=m; begin<size_t(n-m); begin=(begin/chunk+1)*chunk)
+    {
+      int const end = std::min((begin/chunk+1)*chunk, size_t(n-m));
+      boost::function<void ()> task;
+      if (op.isCentral3())
+      {
+        task = boost::bind(interior<Tterms>, y, int(begin), end, dt,
+            y_dif2, y_dif, features);
+      } else
+      {
+        task = boost::bind(interiorFir<Tterms>, y, int(begin), end,
+            c1.data(), c2.data(), m, y_dif2, y_dif, features);
+      }
+      if (size_t(end) >= size_t(n-m)) { task(); }
+      else { threads.create_thread(task); }
+    }
+    threads.join_all();
+
+    // edges
+    for (int j=0; j<n; ++j)
+    {
+      if (j == m) { j = n-m; }
+      int const source = (j < m) ? m : n-m-1;
+      y_dif2[j] = y_dif2[source];
+      y_dif[j] = y_dif[source];
+      Tterms::store(y[j], y_dif[j], features, j);
+    }
+  } // function fused
+
+} // namespace prepare
+
+#endif // include guard
+
+/* ----- END OF prepare.h  ----- */
@@ -0,0 +1,63 @@
+/*! \file prune.cc
+ * \brief Implementation of the early abort of nodes which cannot be among
+ * the best nodes.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Implementation of the early abort of nodes which cannot be among
+ * the best nodes.
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <string>
+#include <limits>
+#include "prune.h"
+
+/* -------------------------------------------------------------------------- */
+TopKThreshold::TopKThreshold(size_t k) : Mk(k),
+  Mbound(std::numeric_limits<double>::infinity())
+{
+  if (0 == Mk) { throw std::string("Illegal number of best nodes."); }
+} // constructor TopKThreshold
+
+/* -------------------------------------------------------------------------- */
+void TopKThreshold::offer(double rms)
+{
+  if (! (rms < bound())) { return; }
+  boost::mutex::scoped_lock lock(Mmutex);
+  Mbest.push(rms);
+  if (Mbest.size() > Mk) { Mbest.pop(); }
+  if (Mbest.size() == Mk)
+  {
+    Mbound.store(Mbest.top(), std::memory_order_relaxed);
+  }
+} // function TopKThreshold::offer
+
+/* ----- END OF prune.cc  ----- */
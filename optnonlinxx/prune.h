@@ -0,0 +1,122 @@
+/*! \file prune.h
+ * \brief Declaration of the early abort of nodes which cannot be among the
+ * best nodes.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Declaration of the early abort of nodes which cannot be among the
+ * best nodes. The numerator of the RMS misfit only grows while the samples
+ * are summed up. As soon as the partial sum of a node exceeds the RMS misfit
+ * of the K-th best node found so far the node is abandoned.
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <queue>
+#include <algorithm>
+#include <vector>
+#include <atomic>
+#include <boost/thread/mutex.hpp>
+#include "kernel.h"
+
+#ifndef _OPTNONLIN_PRUNE_H_
+#define _OPTNONLIN_PRUNE_H_
+
+/*!
+ * RMS misfit of the K-th best node found so far shared by all threads
+ *
+ * Reading the bound does not lock. Only nodes improving the bound acquire
+ * the lock to update the list of the best misfits.
+ */
+class TopKThreshold
+{
+  public:
+    //! constructor
+    TopKThreshold(size_t k);
+    //! current bound (infinity until K nodes were offered)
+    double bound() const { return Mbound.load(std::memory_order_relaxed); }
+    //! offer the RMS misfit of a completely computed node
+    void offer(double rms);
+
+  private:
+    //! number of best nodes
+    size_t const Mk;
+    //! best misfits (largest on top)
+    std::priority_queue<double> Mbest;
+    //! lock of Mbest
+    boost::mutex Mmutex;
+    //! current bound
+    std::atomic<double> Mbound;
+
+}; // class TopKThreshold
+
+/*!
+ * accumulate the misfit sums of a block of nodes tile by tile and abort
+ * nodes whose partial RMS sum exceeds the bound
+ *
+ * \param n number of samples
+ * \param count number of nodes
+ * \param tile function returning the sums of node \c i for the samples
+ * \c j to \c j+len-1; called as \c tile(i, j, len)
+ * \param norm denominator of the squared RMS misfit
+ * \param threshold shared bound
+ * \param sums receives the (partial) sums of the nodes
+ * \param pruned receives the flags if a node was aborted
+ */
+template <typename Ttile>
+void accumulatePruned(int n, int count, Ttile const& tile, double norm,
+    TopKThreshold const& threshold, std::vector<kernel::MisfitSums>& sums,
+    std::vector<bool>& pruned)
+{
+  sums.assign(count, kernel::MisfitSums());
+  pruned.assign(count, false);
+  std::vector<int> active;
+  for (int i=0; i<count; ++i) { active.push_back(i); }
+  for (int j=0; j<n && ! active.empty(); j+=kernel::tileSize)
+  {
+    int const len = std::min(kernel::tileSize, n-j);
+    double const bound = threshold.bound();
+    double const limit = bound*bound*norm;
+    std::vector<int>::iterator last = active.begin();
+    for (std::vector<int>::iterator it(active.begin()); it != active.end();
+        ++it)
+    {
+      kernel::MisfitSums const part = tile(*it, j, len);
+      sums[*it].md += part.md;
+      sums[*it].rms += part.rms;
+      if (sums[*it].rms > limit) { pruned[*it] = true; }
+      else { *last++ = *it; }
+    }
+    active.erase(last, active.end());
+  }
+} // function accumulatePruned
+
+#endif // include guard
+
+/* ----- END OF prune.h  ----- */
@@ -0,0 +1,225 @@
+/*! \file refinement.cc
+ * \brief Implementation of the adaptive coarse-to-fine grid refinement.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Implementation of the adaptive coarse-to-fine grid refinement.
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  Pruned nodes are ranked last.
+ *
+ * ============================================================================
+ */
+
+#include <cmath>
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include "refinement.h"
+
+/* -------------------------------------------------------------------------- */
+AdaptiveRefinement::AdaptiveRefinement(
+    std::vector<std::shared_ptr<Tparameter>> const& params, int levels,
+    size_t best, double threshold) :
+  Mparams(params), Mlevels(levels), Mbest(best), Mthreshold(threshold)
+{
+  if (0 > Mlevels || 30 < Mlevels)
+  {
+    throw std::string("Illegal number of levels.");
+  }
+  for (auto cit(Mparams.cbegin()); cit != Mparams.cend(); ++cit)
+  {
+    if (0 >= (*cit)->getDelta())
+    {
+      throw std::string("Illegal stepwidth of parameter '"+(*cit)->getId()+
+          "'.");
+    }
+    // tolerance to keep the upper boundary despite rounding errors
+    Mlast.push_back(static_cast<long>(floor(
+            ((*cit)->getEnd()-(*cit)->getStart())/(*cit)->getDelta()+1e-6)));
+  }
+} // constructor AdaptiveRefinement
+
+/* -------------------------------------------------------------------------- */
+void AdaptiveRefinement::execute(Tevaluation const& evaluate, bool verbose)
+{
+  Mnodes.clear();
+  size_t const n = Mparams.size();
+  // stepwidth of the current level in units of the full grid
+  long step = 1L << Mlevels;
+
+  Tnodes levelNodes;
+  std::set<Tkey> pending;
+  collect(Tkey(n, 0), Mlast, step, levelNodes, pending);
+  compute(pending, 0, levelNodes, evaluate);
+  for (int level=1; level<=Mlevels; ++level)
+  {
+    // select the cells to refine
+    std::vector<RefinedNode const*> ranked;
+    for (auto cit(levelNodes.cbegin()); cit != levelNodes.cend(); ++cit)
+    {
+      ranked.push_back(&cit->second);
+    }
+    size_t const best = std::min(Mbest, ranked.size());
+    std::partial_sort(ranked.begin(), ranked.begin()+best, ranked.end(),
+        [](RefinedNode const* n1, RefinedNode const* n2) -> bool
+        {
+          if (n1->result.isPruned() != n2->result.isPruned())
+          {
+            return n2->result.isPruned();
+          }
+          return n1->result.getRmsMisfit() < n2->result.getRmsMisfit();
+        });
+    size_t selected = best;
+    if (0 < Mthreshold)
+    {
+      selected = std::partition(ranked.begin()+best, ranked.end(),
+          [this](RefinedNode const* node) -> bool
+          {
+            return ! node->result.isPruned() &&
+              node->result.getRmsMisfit() < Mthreshold;
+          }) - ranked.begin();
+    }
+
+    // subdivide the cells; the nodes of all cells are evaluated at once
+    Tnodes nextNodes;
+    pending.clear();
+    Tkey first(n), last(n);
+    for (size_t k=0; k<selected; ++k)
+    {
+      Tkey const x(key(ranked[k]->coordinates));
+      for (size_t i=0; i<n; ++i)
+      {
+        first[i] = std::max(0L, x[i]-step);
+        last[i] = std::min(Mlast[i], x[i]+step);
+      }
+      collect(first, last, step/2, nextNodes, pending);
+    }
+    if (verbose)
+    {
+      std::cout << "optnonlin: Refining " << selected << " of "
+        << ranked.size() << " cells on level " << level << " ("
+        << pending.size() << " new nodes) ..." << std::endl;
+    }
+    compute(pending, level, nextNodes, evaluate);
+    step /= 2;
+    levelNodes.swap(nextNodes);
+  }
+} // function AdaptiveRefinement::execute
+
+/* -------------------------------------------------------------------------- */
+std::vector<RefinedNode> AdaptiveRefinement::nodes() const
+{
+  std::vector<RefinedNode> retval;
+  retval.reserve(Mnodes.size());
+  for (auto cit(Mnodes.cbegin()); cit != Mnodes.cend(); ++cit)
+  {
+    retval.push_back(cit->second);
+  }
+  return retval;
+} // function AdaptiveRefinement::nodes
+
+/* -------------------------------------------------------------------------- */
+void AdaptiveRefinement::collect(Tkey const& first, Tkey const& last,
+    long step, Tnodes& level_nodes, std::set<Tkey>& pending) const
+{
+  size_t const n = first.size();
+  for (size_t i=0; i<n; ++i)
+  {
+    if (first[i] > last[i]) { return; }
+  }
+  Tkey k(first);
+  while (true)
+  {
+    auto const it = Mnodes.find(k);
+    if (it != Mnodes.end()) { level_nodes.insert(*it); }
+    else { pending.insert(k); }
+    // next position; the last coordinate varies fastest
+    size_t i = n;
+    for (; i > 0; --i)
+    {
+      k[i-1] += step;
+      if (k[i-1] <= last[i-1]) { break; }
+      k[i-1] = first[i-1];
+    }
+    if (0 == i) { return; }
+  }
+} // function AdaptiveRefinement::collect
+
+/* -------------------------------------------------------------------------- */
+void AdaptiveRefinement::compute(std::set<Tkey> const& pending, int level,
+    Tnodes& level_nodes, Tevaluation const& evaluate)
+{
+  std::vector<std::unique_ptr<TnodeType>> owned;
+  std::vector<TnodeType*> nodes;
+  owned.reserve(pending.size());
+  for (auto cit(pending.cbegin()); cit != pending.cend(); ++cit)
+  {
+    owned.push_back(std::unique_ptr<TnodeType>(
+          new TnodeType(coordinates(*cit))));
+    nodes.push_back(owned.back().get());
+  }
+  if (nodes.empty()) { return; }
+  evaluate(nodes);
+
+  auto kit(pending.cbegin());
+  for (size_t i=0; i<nodes.size(); ++i, ++kit)
+  {
+    RefinedNode node;
+    node.coordinates = nodes[i]->getCoordinates();
+    node.result = nodes[i]->getResultData();
+    node.level = level;
+    level_nodes.insert(std::make_pair(*kit, node));
+    Mnodes.insert(std::make_pair(*kit, node));
+  }
+} // function AdaptiveRefinement::compute
+
+/* -------------------------------------------------------------------------- */
+AdaptiveRefinement::Tkey AdaptiveRefinement::key(
+    std::vector<TcoordType> const& coordinates) const
+{
+  Tkey retval(coordinates.size());
+  for (size_t i=0; i<coordinates.size(); ++i)
+  {
+    retval[i] = lround((coordinates[i]-Mparams[i]->getStart())/
+        Mparams[i]->getDelta());
+  }
+  return retval;
+} // function AdaptiveRefinement::key
+
+/* -------------------------------------------------------------------------- */
+std::vector<TcoordType> AdaptiveRefinement::coordinates(Tkey const& key) const
+{
+  std::vector<TcoordType> retval(key.size());
+  for (size_t i=0; i<key.size(); ++i)
+  {
+    retval[i] = Mparams[i]->getStart()+key[i]*Mparams[i]->getDelta();
+  }
+  return retval;
+} // function AdaptiveRefinement::coordinates
+
+/* ----- END OF refinement.cc  ----- */
@@ -0,0 +1,156 @@
+/*! \file refinement.h
+ * \brief Declaration of the adaptive coarse-to-fine grid refinement.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Declaration of the adaptive coarse-to-fine grid refinement. The
+ * search starts on a coarse grid whose stepwidths are the requested ones
+ * multiplied by 2^L. The cells around the best nodes are subdivided level by
+ * level until the requested stepwidths are reached. Each cell is searched
+ * with an ordinary opt::GridSearch built by the
+ * opt::StandardParameterSpaceBuilder, so nodes of the finest level are
+ * evaluated exactly like on the full grid.
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <map>
+#include <set>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <optimizexx/parameter.h>
+#include "types.h"
+#include "batch.h"
+
+#ifndef _OPTNONLIN_REFINEMENT_H_
+#define _OPTNONLIN_REFINEMENT_H_
+
+namespace opt = optimize;
+
+//! node evaluated during the refinement
+struct RefinedNode
+{
+  //! coordinates of the node
+  std::vector<TcoordType> coordinates;
+  //! result of the node
+  TresultType result;
+  //! coarsest level the node was evaluated at (0: coarse grid)
+  int level;
+}; // struct RefinedNode
+
+/*!
+ * adaptive coarse-to-fine search
+ *
+ * A cell of level \f$l\f$ around the node \f$x\f$ is the box
+ * \f$[x-\Delta_l, x+\Delta_l]\f$ clipped to the search range where
+ * \f$\Delta_l = 2^{L-l}\delta\f$. It is searched with stepwidth
+ * \f$\Delta_{l+1}\f$. A cell is refined if its node is among the best nodes
+ * of its level or its RMS misfit is below a threshold. Since all stepwidths
+ * are multiples of the requested stepwidth every node lies on the full grid.
+ *
+ * The nodes of all cells of a level are collected first. Nodes shared by
+ * adjacent cells and nodes evaluated on a coarser level are evaluated only
+ * once; the remaining nodes of a level are evaluated in a single pass.
+ */
+class AdaptiveRefinement
+{
+  public:
+    //! type of the unknown parameters
+    typedef opt::StandardParameter<TcoordType> Tparameter;
+    //! function evaluating a list of nodes
+    typedef std::function<void (std::vector<TnodeType*> const&)> Tevaluation;
+
+    /*!
+     * constructor
+     *
+     * \param params unknown parameters in coordinate order
+     * \param levels number of refinement levels \f$L\f$
+     * \param best number of best nodes of a level whose cells are refined
+     * \param threshold cells of nodes with an RMS misfit below this value are
+     * refined as well (ignored if not positive)
+     */
+    AdaptiveRefinement(std::vector<std::shared_ptr<Tparameter>> const& params,
+        int levels, size_t best, double threshold);
+
+    /*!
+     * perform the search
+     *
+     * \param evaluate function evaluating the new nodes of a level
+     * \param verbose verbosity flag
+     */
+    void execute(Tevaluation const& evaluate, bool verbose=false);
+
+    //! evaluated nodes ordered by their position on the full grid
+    std::vector<RefinedNode> nodes() const;
+
+  private:
+    //! position of a node on the full grid
+    typedef std::vector<long> Tkey;
+    //! evaluated nodes
+    typedef std::map<Tkey, RefinedNode> Tnodes;
+
+    /*!
+     * collect the nodes of a box on the full grid
+     *
+     * Nodes evaluated already are added to \a level_nodes, all others to
+     * \a pending.
+     *
+     * \param first first position of the box
+     * \param last last position of the box
+     * \param step stepwidth in units of the full grid
+     */
+    void collect(Tkey const& first, Tkey const& last, long step,
+        Tnodes& level_nodes, std::set<Tkey>& pending) const;
+    //! evaluate the pending nodes and store them in \a level_nodes
+    void compute(std::set<Tkey> const& pending, int level,
+        Tnodes& level_nodes, Tevaluation const& evaluate);
+    //! position of coordinates on the full grid
+    Tkey key(std::vector<TcoordType> const& coordinates) const;
+    //! coordinates of a position on the full grid
+    std::vector<TcoordType> coordinates(Tkey const& key) const;
+
+    //! unknown parameters in coordinate order
+    std::vector<std::shared_ptr<Tparameter>> Mparams;
+    //! number of refinement levels
+    int Mlevels;
+    //! number of best nodes refined per level
+    size_t Mbest;
+    //! misfit threshold
+    double Mthreshold;
+    //! last position of the full grid
+    Tkey Mlast;
+    //! all evaluated nodes
+    Tnodes Mnodes;
+
+}; // class AdaptiveRefinement
+
+#endif // include guard
+
+/* ----- END OF refinement.h  ----- */
@@ -30,6 +30,9 @@
  * 
  * REVISIONS and CHANGES 
  * 22/04/2012  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  Write the values of profiled parameters.
+ * 16/10/2026  V0.3  Mark pruned nodes.
+ * 16/10/2026  V0.4  Values of a binary table row.
  * 
  * ============================================================================
  */
@@ -58,9 +61,23 @@ void OptResult::write(std::ostream& os) const
   std::stringstream ss;
   ss << std::right << std::setw(12) << MmdMisfit
     << std::setw(12) << std::right << std::fixed << MrmsMisfit;
+  for (std::vector<double>::const_iterator cit(Mparameters.begin());
+      cit != Mparameters.end(); ++cit)
+  {
+    ss << " " << std::setw(12) << std::right << std::fixed << *cit;
+  }
+  if (Mpruned) { ss << " pruned"; }
 
   os << ss.str() << std::endl;
 }
 
+/*---------------------------------------------------------------------------*/
+void OptResult::appendValues(std::vector<double>& row) const
+{
+  row.push_back(MmdMisfit);
+  row.push_back(MrmsMisfit);
+  row.insert(row.end(), Mparameters.begin(), Mparameters.end());
+  row.push_back(Mpruned ? 1. : 0.);
+}
 
 /* ----- END OF result.cc  ----- */
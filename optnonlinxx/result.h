@@ -30,11 +30,15 @@
  * 
  * REVISIONS and CHANGES 
  * 22/04/2012  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  Hold the values of profiled parameters.
+ * 16/10/2026  V0.3  Flag nodes whose computation was aborted.
+ * 16/10/2026  V0.4  Provide the values of a binary table row.
  * 
  * ============================================================================
  */
 
 #include <iostream>
+#include <vector>
  
 #ifndef _OPTNONLIN_RESULT_H_
 #define _OPTNONLIN_RESULT_H_
@@ -43,17 +47,45 @@ class OptResult
 {
   public:
     //! constructor
-    OptResult() : MmdMisfit(0), MrmsMisfit(0) { }
+    OptResult() : MmdMisfit(0), MrmsMisfit(0), Mpruned(false) { }
     //! constructor
     OptResult(double md_misfit, double rms_misfit) : MmdMisfit(md_misfit),
-      MrmsMisfit(rms_misfit)
+      MrmsMisfit(rms_misfit), Mpruned(false)
+    { }
+    /*!
+     * constructor
+     *
+     * \param pruned flag if the computation was aborted since the node
+     * cannot be among the best nodes; the misfits then are lower bounds
+     */
+    OptResult(double md_misfit, double rms_misfit, bool pruned) :
+      MmdMisfit(md_misfit), MrmsMisfit(rms_misfit), Mpruned(pruned)
+    { }
+    /*!
+     * constructor
+     *
+     * \param parameters optimal values of the parameters which were not
+     * gridded but solved for at the node (variable projection)
+     */
+    OptResult(double md_misfit, double rms_misfit,
+        std::vector<double> const& parameters) : MmdMisfit(md_misfit),
+      MrmsMisfit(rms_misfit), Mparameters(parameters), Mpruned(false)
     { }
     //! query functions for data
     double const& getMdMisfit() const { return MmdMisfit; }
     double const& getRmsMisfit() const { return MrmsMisfit; }
+    std::vector<double> const& getParameters() const { return Mparameters; }
+    bool isPruned() const { return Mpruned; }
 
     //! write header line to output stream
     void writeHeaderLine(std::ostream& os) const;
+    /*!
+     * append the values of a binary table row
+     *
+     * The values are the MD misfit, the RMS misfit, the profiled parameters
+     * and 1 if the node was pruned (0 otherwise).
+     */
+    void appendValues(std::vector<double>& row) const;
     //! output stream operator
     friend std::ostream& operator<<(
         std::ostream& os, OptResult const& result);
@@ -67,6 +99,10 @@ class OptResult
     double MmdMisfit;
     //! RMS (root mean square) misfit
     double MrmsMisfit;
+    //! values of the profiled parameters
+    std::vector<double> Mparameters;
+    //! flag if the computation was aborted
+    bool Mpruned;
 
 }; // class OptResults
 
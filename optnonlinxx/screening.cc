@@ -0,0 +1,213 @@
+/*! \file screening.cc
+ * \brief Implementation of the screening of parameter space nodes on
+ * decimated data.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Implementation of the screening of parameter space nodes on
+ * decimated data.
+ *
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <optimizexx/iterator.h>
+#include "screening.h"
+
+/* -------------------------------------------------------------------------- */
+ScreeningVisitor::ScreeningVisitor(
+    opt::ParameterSpaceVisitor<TcoordType, TresultType>& coarse,
+    opt::ParameterSpaceVisitor<TcoordType, TresultType>& full,
+    double margin, double keep) : Mcoarse(coarse), Mfull(full),
+  MfullBatch(dynamic_cast<BatchVisitor*>(&full)), Mmargin(margin),
+  Mkeep(keep), Mthreshold(std::numeric_limits<double>::infinity()),
+  Mscreened(0), Meliminated(0), Mcompared(0), MmaxDeviation(0),
+  MsumDeviation(0), Mchecked(0), Mmissed(0)
+{
+  if (0 > margin || 0 > keep || 1 < keep)
+  {
+    throw std::string("Illegal screening settings.");
+  }
+} // ScreeningVisitor::ScreeningVisitor
+
+/* -------------------------------------------------------------------------- */
+void ScreeningVisitor::screen(
+    opt::GlobalAlgorithm<TcoordType, TresultType>& algo)
+{
+  algo.execute(Mcoarse);
+  threshold(collectNodes(algo));
+} // function ScreeningVisitor::screen
+
+/* -------------------------------------------------------------------------- */
+void ScreeningVisitor::screen(std::vector<TnodeType*> const& nodes,
+    size_t num_threads)
+{
+  NodeBatchVisitor coarse(Mcoarse);
+  executeBatched(nodes, coarse, 1, num_threads);
+  threshold(nodes);
+} // function ScreeningVisitor::screen
+
+/* -------------------------------------------------------------------------- */
+void ScreeningVisitor::threshold(std::vector<TnodeType*> const& nodes)
+{
+  std::vector<double> misfits;
+  for (auto cit(nodes.cbegin()); cit != nodes.cend(); ++cit)
+  {
+    misfits.push_back((*cit)->getResultData().getRmsMisfit());
+  }
+  if (misfits.empty()) { return; }
+  std::sort(misfits.begin(), misfits.end());
+  size_t const kept = static_cast<size_t>(ceil(Mkeep*misfits.size()));
+  Mthreshold = misfits.front()*(1.+Mmargin);
+  if (kept) { Mthreshold = std::max(Mthreshold, misfits[kept-1]); }
+
+  boost::mutex::scoped_lock lock(Mmutex);
+  Mscreened += misfits.size();
+} // function ScreeningVisitor::threshold
+
+/* -------------------------------------------------------------------------- */
+void ScreeningVisitor::check(
+    opt::GlobalAlgorithm<TcoordType, TresultType>& algo, size_t count)
+{
+  check(collectNodes(algo), count);
+} // function ScreeningVisitor::check
+
+/* -------------------------------------------------------------------------- */
+void ScreeningVisitor::check(std::vector<TnodeType*> const& all,
+    size_t count)
+{
+  std::vector<TnodeType*> nodes;
+  for (auto cit(all.cbegin()); cit != all.cend(); ++cit)
+  {
+    if ((*cit)->getResultData().isPruned()) { nodes.push_back(*cit); }
+  }
+  if (0 == count || nodes.empty()) { return; }
+  size_t const step = std::max(size_t(1), nodes.size()/count);
+  for (size_t i=0; i<nodes.size(); i+=step)
+  {
+    TresultType const screened(nodes[i]->getResultData());
+    Mfull(nodes[i]);
+    TresultType const& full(nodes[i]->getResultData());
+    if (! full.isPruned())
+    {
+      ++Mchecked;
+      if (full.getRmsMisfit() <= Mthreshold) { ++Mmissed; }
+    }
+    nodes[i]->setResultData(screened);
+  }
+} // function ScreeningVisitor::check
+
+/* -------------------------------------------------------------------------- */
+void ScreeningVisitor::report(std::ostream& os) const
+{
+  boost::mutex::scoped_lock lock(Mmutex);
+  os << "optnonlin: Screening eliminated " << Meliminated << " of "
+    << Mscreened << " nodes." << std::endl;
+  os << "optnonlin: Deviation of the screened from the full RMS misfit on "
+    << Mcompared << " nodes: maximum " << MmaxDeviation << ", mean "
+    << (Mcompared ? MsumDeviation/Mcompared : 0.) << std::endl;
+  if (Mchecked)
+  {
+    os << "optnonlin: " << Mmissed << " of " << Mchecked
+      << " checked eliminated nodes are below the screening threshold on "
+      << "the full data." << std::endl;
+  }
+} // function ScreeningVisitor::report
+
+/* -------------------------------------------------------------------------- */
+void ScreeningVisitor::operator()(TnodeType* node)
+{
+  if (eliminate(node)) { return; }
+  double const screened = node->getResultData().getRmsMisfit();
+  Mfull(node);
+  record(screened, node);
+} // function ScreeningVisitor::operator()
+
+/* -------------------------------------------------------------------------- */
+void ScreeningVisitor::visitBatch(TnodeType* const* nodes, int count)
+{
+  if (! MfullBatch)
+  {
+    for (int i=0; i<count; ++i) { (*this)(nodes[i]); }
+    return;
+  }
+  std::vector<TnodeType*> kept;
+  std::vector<double> screened;
+  for (int i=0; i<count; ++i)
+  {
+    if (! eliminate(nodes[i]))
+    {
+      kept.push_back(nodes[i]);
+      screened.push_back(nodes[i]->getResultData().getRmsMisfit());
+    }
+  }
+  if (kept.empty()) { return; }
+  MfullBatch->visitBatch(&kept[0], kept.size());
+  for (size_t i=0; i<kept.size(); ++i) { record(screened[i], kept[i]); }
+} // function ScreeningVisitor::visitBatch
+
+/* -------------------------------------------------------------------------- */
+void ScreeningVisitor::setPruning(TopKThreshold* threshold)
+{
+  if (! MfullBatch)
+  {
+    throw std::string("Visitor does not support pruning.");
+  }
+  MfullBatch->setPruning(threshold);
+} // function ScreeningVisitor::setPruning
+
+/* -------------------------------------------------------------------------- */
+bool ScreeningVisitor::eliminate(TnodeType* node)
+{
+  TresultType const& screened(node->getResultData());
+  if (screened.getRmsMisfit() <= Mthreshold) { return false; }
+  node->setResultData(TresultType(screened.getMdMisfit(),
+        screened.getRmsMisfit(), true));
+  boost::mutex::scoped_lock lock(Mmutex);
+  ++Meliminated;
+  return true;
+} // function ScreeningVisitor::eliminate
+
+/* -------------------------------------------------------------------------- */
+void ScreeningVisitor::record(double screened, TnodeType const* node)
+{
+  TresultType const& full(node->getResultData());
+  if (full.isPruned()) { return; }
+  double const deviation = fabs(screened-full.getRmsMisfit());
+  boost::mutex::scoped_lock lock(Mmutex);
+  ++Mcompared;
+  MsumDeviation += deviation;
+  MmaxDeviation = std::max(MmaxDeviation, deviation);
+} // function ScreeningVisitor::record
+
+/* ----- END OF screening.cc  ----- */
@@ -0,0 +1,170 @@
+/*! \file screening.h
+ * \brief Declaration of the screening of parameter space nodes on decimated
+ * data.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Declaration of the screening of parameter space nodes on
+ * decimated data. The misfit of all nodes is computed on lowpass filtered
+ * and decimated time series first. Only the nodes of the promising region
+ * are computed on the full time series afterwards.
+ *
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <cstddef>
+#include <iostream>
+#include <boost/thread/mutex.hpp>
+#include <optimizexx/node.h>
+#include <optimizexx/application.h>
+#include <optimizexx/globalalgorithms/gridsearch.h>
+#include "types.h"
+#include "batch.h"
+
+#ifndef _OPTNONLIN_SCREENING_H_
+#define _OPTNONLIN_SCREENING_H_
+
+namespace opt = optimize;
+
+/*!
+ * visitor computing only the nodes which passed the screening
+ *
+ * screen() sends the coarse visitor through all nodes of a grid and derives
+ * the screening threshold from their RMS misfits: nodes are kept if their
+ * misfit does not exceed the best misfit by more than the margin or if they
+ * are among the best fraction of all nodes. Visiting the nodes afterwards
+ * computes the kept nodes with the full visitor. The remaining nodes keep
+ * the screened result marked as pruned.
+ */
+class ScreeningVisitor :
+  public opt::ParameterSpaceVisitor<TcoordType, TresultType>,
+  public BatchVisitor
+{
+  public:
+    /*!
+     * constructor
+     *
+     * \param coarse visitor computing the misfit on decimated data
+     * \param full visitor computing the misfit on the full data
+     * \param margin relative margin of the screening threshold above the
+     * best screened RMS misfit
+     * \param keep fraction of nodes which are kept at least
+     */
+    ScreeningVisitor(
+        opt::ParameterSpaceVisitor<TcoordType, TresultType>& coarse,
+        opt::ParameterSpaceVisitor<TcoordType, TresultType>& full,
+        double margin, double keep);
+    /*!
+     * compute the screened misfit of all nodes of a grid
+     *
+     * \param algo global algorithm with a constructed parameter space
+     */
+    void screen(opt::GlobalAlgorithm<TcoordType, TresultType>& algo);
+    /*!
+     * compute the screened misfit of a list of nodes
+     *
+     * \param nodes nodes to screen
+     * \param num_threads number of threads to start
+     */
+    void screen(std::vector<TnodeType*> const& nodes, size_t num_threads);
+    /*!
+     * recompute eliminated nodes on the full data
+     *
+     * The screened results of the nodes are restored afterwards.
+     *
+     * \param algo global algorithm visited after screen()
+     * \param count maximum number of nodes to check
+     */
+    void check(opt::GlobalAlgorithm<TcoordType, TresultType>& algo,
+        size_t count);
+    /*!
+     * recompute eliminated nodes of a list on the full data
+     *
+     * \param nodes nodes visited after screen()
+     * \param count maximum number of nodes to check
+     */
+    void check(std::vector<TnodeType*> const& nodes, size_t count);
+    //! write statistics of all screened grids
+    void report(std::ostream& os) const;
+
+    //! visit function for a grid
+    virtual void operator()(opt::Grid<TcoordType, TresultType>* grid)
+    {
+      Mfull(grid);
+    }
+    //! visit function for a node
+    virtual void operator()(TnodeType* node);
+    //! evaluate a block of nodes
+    virtual void visitBatch(TnodeType* const* nodes, int count);
+    //! abort nodes which cannot be among the best nodes
+    virtual void setPruning(TopKThreshold* threshold);
+
+  private:
+    //! derive the screening threshold from the screened nodes
+    void threshold(std::vector<TnodeType*> const& nodes);
+    //! eliminate a node; returns false if the node must be computed
+    bool eliminate(TnodeType* node);
+    //! record the deviation of the screened from the full misfit
+    void record(double screened, TnodeType const* node);
+
+    //! visitor computing the misfit on decimated data
+    opt::ParameterSpaceVisitor<TcoordType, TresultType>& Mcoarse;
+    //! visitor computing the misfit on the full data
+    opt::ParameterSpaceVisitor<TcoordType, TresultType>& Mfull;
+    //! batch interface of the full visitor (0 if not available)
+    BatchVisitor* MfullBatch;
+    //! relative margin above the best screened misfit
+    double const Mmargin;
+    //! fraction of nodes kept at least
+    double const Mkeep;
+    //! screening threshold of the current grid
+    double Mthreshold;
+    //! number of screened nodes
+    size_t Mscreened;
+    //! number of eliminated nodes
+    size_t Meliminated;
+    //! number of nodes computed on the full data
+    size_t Mcompared;
+    //! maximum deviation of the screened from the full RMS misfit
+    double MmaxDeviation;
+    //! sum of the deviations
+    double MsumDeviation;
+    //! number of checked eliminated nodes
+    size_t Mchecked;
+    //! number of checked nodes below the threshold on the full data
+    size_t Mmissed;
+    //! lock of the statistics
+    mutable boost::mutex Mmutex;
+
+}; // class ScreeningVisitor
+
+#endif // include guard
+
+/* ----- END OF screening.h  ----- */
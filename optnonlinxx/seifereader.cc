@@ -0,0 +1,188 @@
+/*! \file seifereader.cc
+ * \brief Implementation of the parallel reader of seife files.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Implementation of the parallel reader of seife files.
+ *
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdlib>
+#include <cctype>
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+#include <datrwxx/readany.h>
+#include "seifereader.h"
+
+namespace
+{
+  //! return the position of the line following the line at \a pos
+  size_t nextLine(std::string const& buffer, size_t pos)
+  {
+    pos = buffer.find('\n', pos);
+    return std::string::npos == pos ? buffer.size() : pos+1;
+  }
+
+  //! decode the field of \a width characters at \a pos of \a line
+  std::string field(std::string const& line, size_t pos, size_t width)
+  {
+    return pos < line.size() ? line.substr(pos, width) : std::string();
+  }
+
+  //! parse the samples of the lines from \a first to \a last
+  void parseChunk(char const* first, char const* last,
+      std::vector<double>& samples, std::string& error)
+  {
+    char const* c = first;
+    while (true)
+    {
+      while (c < last && isspace(*c)) { ++c; }
+      if (c >= last) { break; }
+      char* end = 0;
+      double const value = strtod(c, &end);
+      if (end == c || (end < last && ! isspace(*end)))
+      {
+        char const* eot = c;
+        while (eot < last && ! isspace(*eot)) { ++eot; }
+        error = "Illegal sample '"+std::string(c, eot)+"'.";
+        return;
+      }
+      samples.push_back(value);
+      c = end;
+    }
+  } // function parseChunk
+} // namespace (unnamed)
+
+/* -------------------------------------------------------------------------- */
+void readSeife(std::string const& filename, size_t num_threads,
+    datrw::Tdseries& series, sff::WID2& wid2)
+{
+  std::ifstream ifs(filename.c_str(), std::ios::in | std::ios::binary);
+  if (! ifs.good()) { throw std::string("Cannot open input file!"); }
+  ifs.seekg(0, std::ios::end);
+  std::streamoff const length = ifs.tellg();
+  if (0 > length) { throw std::string("Cannot read input file!"); }
+  std::string buffer(static_cast<size_t>(length), '\0');
+  ifs.seekg(0, std::ios::beg);
+  // strtod requires a terminated buffer which std::string provides
+  if (! buffer.empty()) { ifs.read(&buffer[0], buffer.size()); }
+  if (! ifs.good()) { throw std::string("Cannot read input file!"); }
+
+  // header: line of free text, then nsamples, format, dt, tmin and tsec
+  size_t const second = nextLine(buffer, 0);
+  size_t size = nextLine(buffer, second);
+  std::string const line(buffer, second, size-second);
+  char* end = 0;
+  std::string const nfield(field(line, 0, 10));
+  long const nsamples = strtol(nfield.c_str(), &end, 10);
+  std::string const dtfield(field(line, 30, 10));
+  double const dt = strtod(dtfield.c_str(), 0);
+  if (end == nfield.c_str() || 0 >= nsamples || 0. >= dt)
+  {
+    throw std::string("Illegal seife header in '"+filename+"'.");
+  }
+  // comment lines
+  size_t begin = size;
+  while (begin < buffer.size() && '%' == buffer[begin])
+  {
+    begin = nextLine(buffer, begin);
+  }
+
+  // the header fields are decoded by libdatrwxx from a copy of the header
+  // announcing a single sample
+  {
+    std::ostringstream header;
+    header << std::string(buffer, 0, second) << std::setw(10) << 1
+      << std::string(line, std::min(size_t(10), line.size()))
+      << std::string(buffer, size, begin-size);
+    if ('\n' != buffer[begin-1]) { header << "\n"; }
+    header << "0.\n";
+    std::istringstream iss(header.str());
+    datrw::ianystream is(iss, "seife");
+    datrw::Tdseries dummy;
+    is >> dummy;
+    is >> wid2;
+    wid2.nsamples = nsamples;
+  }
+
+  // chunk boundaries of the sample section at line breaks
+  size = buffer.size();
+  char const* data = buffer.c_str();
+  if (0 == num_threads) { num_threads = 1; }
+  std::vector<size_t> bounds(1, begin);
+  for (size_t i=1; i<num_threads; ++i)
+  {
+    size_t const pos = std::max(bounds.back(),
+        begin+i*(size-begin)/num_threads);
+    bounds.push_back(nextLine(buffer, pos));
+  }
+  bounds.push_back(size);
+
+  size_t const chunks = bounds.size()-1;
+  std::vector<std::vector<double>> samples(chunks);
+  std::vector<std::string> errors(chunks);
+  boost::thread_group threads;
+  for (size_t i=0; i<chunks; ++i)
+  {
+    threads.create_thread(boost::bind(parseChunk, data+bounds[i],
+          data+bounds[i+1], boost::ref(samples[i]), boost::ref(errors[i])));
+  }
+  threads.join_all();
+
+  // exactly nsamples values are taken; errors behind them do not matter
+  size_t total = 0;
+  for (size_t i=0; i<chunks && total < size_t(nsamples); ++i)
+  {
+    total += samples[i].size();
+    if (total < size_t(nsamples) && ! errors[i].empty()) { throw errors[i]; }
+  }
+  if (total < size_t(nsamples))
+  {
+    throw std::string("Missing samples in '"+filename+"'.");
+  }
+  series = datrw::Tdseries(nsamples);
+  long k = series.f();
+  for (auto cit(samples.cbegin()); cit != samples.cend(); ++cit)
+  {
+    for (auto sit(cit->cbegin()); sit != cit->cend() && k <= series.l();
+        ++sit)
+    {
+      series(k++) = *sit;
+    }
+  }
+} // function readSeife
+
+/* ----- END OF seifereader.cc  ----- */
@@ -0,0 +1,78 @@
+/*! \file seifereader.h
+ * \brief Declaration of the parallel reader of seife files.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Declaration of the parallel reader of seife files. The header is
+ * decoded serially. The sample section is split into chunks at line
+ * boundaries which are parsed by several threads at once.
+ *
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <string>
+#include <cstddef>
+#include <datrwxx/types.h>
+#include <sffxx.h>
+
+#ifndef _OPTNONLIN_SEIFEREADER_H_
+#define _OPTNONLIN_SEIFEREADER_H_
+
+/*!
+ * read a seife file in parallel
+ *
+ * A seife file starts with a line of free text followed by the line
+ *
+ *   nsamples (format) dt tmin tsec
+ *
+ * in the columns (i10,a20,3f10.x). Comment lines starting with '%' may
+ * follow. The remaining lines contain the samples separated by blanks.
+ * Exactly \c nsamples values are read in free format, the format field is
+ * ignored.
+ *
+ * The header is decoded by libdatrwxx: the header lines with the number of
+ * samples set to one are passed to datrw::ianystream together with a single
+ * sample. Thus all header fields (in particular the date derived from tmin
+ * and tsec) are identical to those of the serial reader; only the number
+ * of samples is taken from the file. The samples are converted with
+ * \c strtod which rounds correctly, so the values are identical to the
+ * values extracted by an input stream.
+ *
+ * \param filename path of the file
+ * \param num_threads number of threads to start
+ * \param series time series read
+ * \param wid2 header of the time series
+ */
+void readSeife(std::string const& filename, size_t num_threads,
+    datrw::Tdseries& series, sff::WID2& wid2);
+
+#endif // include guard
+
+/* ----- END OF seifereader.h  ----- */
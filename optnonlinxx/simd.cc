@@ -0,0 +1,514 @@
+/*! \file simd.cc
+ * \brief Implementation of the vectorized misfit kernels of optnonlin.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Implementation of the vectorized misfit kernels of optnonlin.
+ * Vectorized kernels sum up the samples in a different order than the scalar
+ * kernels do. Thus their results differ in the order of the rounding error.
+ *
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  AVX2 single precision kernels
+ *
+ * ============================================================================
+ */
+
+#include <cmath>
+#include "simd.h"
+
+#ifdef OPTNONLIN_X86_KERNELS
+
+#include <immintrin.h>
+
+namespace kernel
+{
+
+  /* ======================================================================= */
+  namespace sse2
+  {
+    namespace
+    {
+      __attribute__((target("sse2")))
+      inline double hsum(__m128d v)
+      {
+        return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+      }
+
+      __attribute__((target("sse2")))
+      inline __m128d abs(__m128d v)
+      {
+        return _mm_andnot_pd(_mm_set1_pd(-0.), v);
+      }
+    } // namespace (unnamed)
+
+    /* --------------------------------------------------------------------- */
+    __attribute__((target("sse2")))
+    MisfitSums norms(double const* in, int n)
+    {
+      __m128d md = _mm_setzero_pd();
+      __m128d rms = _mm_setzero_pd();
+      int j = 0;
+      for (; j+2<=n; j+=2)
+      {
+        __m128d const v = _mm_loadu_pd(in+j);
+        md = _mm_add_pd(md, abs(v));
+        rms = _mm_add_pd(rms, _mm_mul_pd(v, v));
+      }
+      MisfitSums sums;
+      sums.md = hsum(md);
+      sums.rms = hsum(rms);
+      for (; j<n; ++j)
+      {
+        sums.md += fabs(in[j]);
+        sums.rms += in[j]*in[j];
+      }
+      return sums;
+    } // function norms
+
+    /* --------------------------------------------------------------------- */
+    __attribute__((target("sse2")))
+    MisfitSums linear(double const* in, double const* y_dif2,
+        double const* y_dif, double const* y, int n, double a1, double a2)
+    {
+      __m128d const va1 = _mm_set1_pd(a1);
+      __m128d const va2 = _mm_set1_pd(a2);
+      __m128d md = _mm_setzero_pd();
+      __m128d rms = _mm_setzero_pd();
+      int j = 0;
+      for (; j+2<=n; j+=2)
+      {
+        __m128d r = _mm_add_pd(_mm_loadu_pd(y_dif2+j),
+            _mm_mul_pd(va1, _mm_loadu_pd(y_dif+j)));
+        r = _mm_add_pd(r, _mm_mul_pd(va2, _mm_loadu_pd(y+j)));
+        r = abs(_mm_sub_pd(r, _mm_loadu_pd(in+j)));
+        md = _mm_add_pd(md, r);
+        rms = _mm_add_pd(rms, _mm_mul_pd(r, r));
+      }
+      MisfitSums sums;
+      sums.md = hsum(md);
+      sums.rms = hsum(rms);
+      for (; j<n; ++j)
+      {
+        double const r = fabs(y_dif2[j] + a1*y_dif[j] + a2*y[j] - in[j]);
+        sums.md += r;
+        sums.rms += r*r;
+      }
+      return sums;
+    } // function linear
+
+    /* --------------------------------------------------------------------- */
+    __attribute__((target("sse2")))
+    MisfitSums nonlinear(double const* in, double const* y_dif2,
+        double const* y_dif, double const* y, double const* y_square,
+        double const* y_cube, int n, double a1, double a2, double c0,
+        double c1)
+    {
+      __m128d const va1 = _mm_set1_pd(a1);
+      __m128d const va2 = _mm_set1_pd(a2);
+      __m128d const vc0 = _mm_set1_pd(c0);
+      __m128d const vc1 = _mm_set1_pd(c1);
+      __m128d md = _mm_setzero_pd();
+      __m128d rms = _mm_setzero_pd();
+      int j = 0;
+      for (; j+2<=n; j+=2)
+      {
+        __m128d r = _mm_add_pd(_mm_loadu_pd(y_dif2+j),
+            _mm_mul_pd(va1, _mm_loadu_pd(y_dif+j)));
+        r = _mm_add_pd(r, _mm_mul_pd(va2, _mm_loadu_pd(y+j)));
+        r = _mm_add_pd(r, _mm_mul_pd(vc0, _mm_loadu_pd(y_square+j)));
+        r = _mm_add_pd(r, _mm_mul_pd(vc1, _mm_loadu_pd(y_cube+j)));
+        r = abs(_mm_sub_pd(r, _mm_loadu_pd(in+j)));
+        md = _mm_add_pd(md, r);
+        rms = _mm_add_pd(rms, _mm_mul_pd(r, r));
+      }
+      MisfitSums sums;
+      sums.md = hsum(md);
+      sums.rms = hsum(rms);
+      for (; j<n; ++j)
+      {
+        double const r = fabs(y_dif2[j] + a1*y_dif[j] + a2*y[j] +
+            c0*y_square[j] + c1*y_cube[j] - in[j]);
+        sums.md += r;
+        sums.rms += r*r;
+      }
+      return sums;
+    } // function nonlinear
+
+  } // namespace sse2
+
+  /* ======================================================================= */
+  namespace avx2
+  {
+    namespace
+    {
+      __attribute__((target("avx2")))
+      inline double hsum(__m256d v)
+      {
+        __m128d const s = _mm_add_pd(_mm256_castpd256_pd128(v),
+            _mm256_extractf128_pd(v, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+      }
+
+      __attribute__((target("avx2")))
+      inline __m256d abs(__m256d v)
+      {
+        return _mm256_andnot_pd(_mm256_set1_pd(-0.), v);
+      }
+
+      __attribute__((target("avx2")))
+      inline __m256 abs(__m256 v)
+      {
+        return _mm256_andnot_ps(_mm256_set1_ps(-0.f), v);
+      }
+
+      /*! 
+       * accumulate eight single precision values in double precision
+       * lanes
+       */
+      __attribute__((target("avx2")))
+      inline void accumulate(__m256 v, __m256d& md, __m256d& rms)
+      {
+        __m256d const lo = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+        __m256d const hi = _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+        md = _mm256_add_pd(md, _mm256_add_pd(lo, hi));
+        rms = _mm256_add_pd(rms,
+            _mm256_add_pd(_mm256_mul_pd(lo, lo), _mm256_mul_pd(hi, hi)));
+      }
+    } // namespace (unnamed)
+
+    /* --------------------------------------------------------------------- */
+    __attribute__((target("avx2")))
+    MisfitSums norms(double const* in, int n)
+    {
+      __m256d md = _mm256_setzero_pd();
+      __m256d rms = _mm256_setzero_pd();
+      int j = 0;
+      for (; j+4<=n; j+=4)
+      {
+        __m256d const v = _mm256_loadu_pd(in+j);
+        md = _mm256_add_pd(md, abs(v));
+        rms = _mm256_add_pd(rms, _mm256_mul_pd(v, v));
+      }
+      MisfitSums sums;
+      sums.md = hsum(md);
+      sums.rms = hsum(rms);
+      for (; j<n; ++j)
+      {
+        sums.md += fabs(in[j]);
+        sums.rms += in[j]*in[j];
+      }
+      return sums;
+    } // function norms
+
+    /* --------------------------------------------------------------------- */
+    __attribute__((target("avx2")))
+    MisfitSums linear(double const* in, double const* y_dif2,
+        double const* y_dif, double const* y, int n, double a1, double a2)
+    {
+      __m256d const va1 = _mm256_set1_pd(a1);
+      __m256d const va2 = _mm256_set1_pd(a2);
+      __m256d md = _mm256_setzero_pd();
+      __m256d rms = _mm256_setzero_pd();
+      int j = 0;
+      for (; j+4<=n; j+=4)
+      {
+        __m256d r = _mm256_add_pd(_mm256_loadu_pd(y_dif2+j),
+            _mm256_mul_pd(va1, _mm256_loadu_pd(y_dif+j)));
+        r = _mm256_add_pd(r, _mm256_mul_pd(va2, _mm256_loadu_pd(y+j)));
+        r = abs(_mm256_sub_pd(r, _mm256_loadu_pd(in+j)));
+        md = _mm256_add_pd(md, r);
+        rms = _mm256_add_pd(rms, _mm256_mul_pd(r, r));
+      }
+      MisfitSums sums;
+      sums.md = hsum(md);
+      sums.rms = hsum(rms);
+      for (; j<n; ++j)
+      {
+        double const r = fabs(y_dif2[j] + a1*y_dif[j] + a2*y[j] - in[j]);
+        sums.md += r;
+        sums.rms += r*r;
+      }
+      return sums;
+    } // function linear
+
+    /* --------------------------------------------------------------------- */
+    __attribute__((target("avx2")))
+    MisfitSums nonlinear(double const* in, double const* y_dif2,
+        double const* y_dif, double const* y, double const* y_square,
+        double const* y_cube, int n, double a1, double a2, double c0,
+        double c1)
+    {
+      __m256d const va1 = _mm256_set1_pd(a1);
+      __m256d const va2 = _mm256_set1_pd(a2);
+      __m256d const vc0 = _mm256_set1_pd(c0);
+      __m256d const vc1 = _mm256_set1_pd(c1);
+      __m256d md = _mm256_setzero_pd();
+      __m256d rms = _mm256_setzero_pd();
+      int j = 0;
+      for (; j+4<=n; j+=4)
+      {
+        __m256d r = _mm256_add_pd(_mm256_loadu_pd(y_dif2+j),
+            _mm256_mul_pd(va1, _mm256_loadu_pd(y_dif+j)));
+        r = _mm256_add_pd(r, _mm256_mul_pd(va2, _mm256_loadu_pd(y+j)));
+        r = _mm256_add_pd(r, _mm256_mul_pd(vc0, _mm256_loadu_pd(y_square+j)));
+        r = _mm256_add_pd(r, _mm256_mul_pd(vc1, _mm256_loadu_pd(y_cube+j)));
+        r = abs(_mm256_sub_pd(r, _mm256_loadu_pd(in+j)));
+        md = _mm256_add_pd(md, r);
+        rms = _mm256_add_pd(rms, _mm256_mul_pd(r, r));
+      }
+      MisfitSums sums;
+      sums.md = hsum(md);
+      sums.rms = hsum(rms);
+      for (; j<n; ++j)
+      {
+        double const r = fabs(y_dif2[j] + a1*y_dif[j] + a2*y[j] +
+            c0*y_square[j] + c1*y_cube[j] - in[j]);
+        sums.md += r;
+        sums.rms += r*r;
+      }
+      return sums;
+    } // function nonlinear
+
+    /* --------------------------------------------------------------------- */
+    __attribute__((target("avx2")))
+    MisfitSums norms(float const* in, int n)
+    {
+      __m256d md = _mm256_setzero_pd();
+      __m256d rms = _mm256_setzero_pd();
+      int j = 0;
+      for (; j+8<=n; j+=8)
+      {
+        accumulate(abs(_mm256_loadu_ps(in+j)), md, rms);
+      }
+      MisfitSums sums;
+      sums.md = hsum(md);
+      sums.rms = hsum(rms);
+      for (; j<n; ++j)
+      {
+        double const v = in[j];
+        sums.md += fabs(v);
+        sums.rms += v*v;
+      }
+      return sums;
+    } // function norms
+
+    /* --------------------------------------------------------------------- */
+    __attribute__((target("avx2")))
+    MisfitSums linear(float const* in, float const* y_dif2,
+        float const* y_dif, float const* y, int n, double a1, double a2)
+    {
+      float const fa1 = a1;
+      float const fa2 = a2;
+      __m256 const va1 = _mm256_set1_ps(fa1);
+      __m256 const va2 = _mm256_set1_ps(fa2);
+      __m256d md = _mm256_setzero_pd();
+      __m256d rms = _mm256_setzero_pd();
+      int j = 0;
+      for (; j+8<=n; j+=8)
+      {
+        __m256 r = _mm256_add_ps(_mm256_loadu_ps(y_dif2+j),
+            _mm256_mul_ps(va1, _mm256_loadu_ps(y_dif+j)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(va2, _mm256_loadu_ps(y+j)));
+        accumulate(abs(_mm256_sub_ps(r, _mm256_loadu_ps(in+j))), md, rms);
+      }
+      MisfitSums sums;
+      sums.md = hsum(md);
+      sums.rms = hsum(rms);
+      for (; j<n; ++j)
+      {
+        double const r = fabsf(y_dif2[j] + fa1*y_dif[j] + fa2*y[j] - in[j]);
+        sums.md += r;
+        sums.rms += r*r;
+      }
+      return sums;
+    } // function linear
+
+    /* --------------------------------------------------------------------- */
+    __attribute__((target("avx2")))
+    MisfitSums nonlinear(float const* in, float const* y_dif2,
+        float const* y_dif, float const* y, float const* y_square,
+        float const* y_cube, int n, double a1, double a2, double c0,
+        double c1)
+    {
+      float const fa1 = a1;
+      float const fa2 = a2;
+      float const fc0 = c0;
+      float const fc1 = c1;
+      __m256 const va1 = _mm256_set1_ps(fa1);
+      __m256 const va2 = _mm256_set1_ps(fa2);
+      __m256 const vc0 = _mm256_set1_ps(fc0);
+      __m256 const vc1 = _mm256_set1_ps(fc1);
+      __m256d md = _mm256_setzero_pd();
+      __m256d rms = _mm256_setzero_pd();
+      int j = 0;
+      for (; j+8<=n; j+=8)
+      {
+        __m256 r = _mm256_add_ps(_mm256_loadu_ps(y_dif2+j),
+            _mm256_mul_ps(va1, _mm256_loadu_ps(y_dif+j)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(va2, _mm256_loadu_ps(y+j)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(vc0, _mm256_loadu_ps(y_square+j)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(vc1, _mm256_loadu_ps(y_cube+j)));
+        accumulate(abs(_mm256_sub_ps(r, _mm256_loadu_ps(in+j))), md, rms);
+      }
+      MisfitSums sums;
+      sums.md = hsum(md);
+      sums.rms = hsum(rms);
+      for (; j<n; ++j)
+      {
+        double const r = fabsf(y_dif2[j] + fa1*y_dif[j] + fa2*y[j] +
+            fc0*y_square[j] + fc1*y_cube[j] - in[j]);
+        sums.md += r;
+        sums.rms += r*r;
+      }
+      return sums;
+    } // function nonlinear
+
+  } // namespace avx2
+
+  /* ======================================================================= */
+  namespace avx512
+  {
+    namespace
+    {
+      __attribute__((target("avx512f")))
+      inline double hsum(__m512d v)
+      {
+        double lanes[8];
+        _mm512_storeu_pd(lanes, v);
+        return ((lanes[0]+lanes[4])+(lanes[1]+lanes[5]))+
+          ((lanes[2]+lanes[6])+(lanes[3]+lanes[7]));
+      }
+
+      __attribute__((target("avx512f")))
+      inline __m512d abs(__m512d v)
+      {
+        return _mm512_castsi512_pd(_mm512_and_epi64(
+              _mm512_castpd_si512(v),
+              _mm512_set1_epi64(0x7fffffffffffffffLL)));
+      }
+    } // namespace (unnamed)
+
+    /* --------------------------------------------------------------------- */
+    __attribute__((target("avx512f")))
+    MisfitSums norms(double const* in, int n)
+    {
+      __m512d md = _mm512_setzero_pd();
+      __m512d rms = _mm512_setzero_pd();
+      int j = 0;
+      for (; j+8<=n; j+=8)
+      {
+        __m512d const v = _mm512_loadu_pd(in+j);
+        md = _mm512_add_pd(md, abs(v));
+        rms = _mm512_add_pd(rms, _mm512_mul_pd(v, v));
+      }
+      MisfitSums sums;
+      sums.md = hsum(md);
+      sums.rms = hsum(rms);
+      for (; j<n; ++j)
+      {
+        sums.md += fabs(in[j]);
+        sums.rms += in[j]*in[j];
+      }
+      return sums;
+    } // function norms
+
+    /* --------------------------------------------------------------------- */
+    __attribute__((target("avx512f")))
+    MisfitSums linear(double const* in, double const* y_dif2,
+        double const* y_dif, double const* y, int n, double a1, double a2)
+    {
+      __m512d const va1 = _mm512_set1_pd(a1);
+      __m512d const va2 = _mm512_set1_pd(a2);
+      __m512d md = _mm512_setzero_pd();
+      __m512d rms = _mm512_setzero_pd();
+      int j = 0;
+      for (; j+8<=n; j+=8)
+      {
+        __m512d r = _mm512_add_pd(_mm512_loadu_pd(y_dif2+j),
+            _mm512_mul_pd(va1, _mm512_loadu_pd(y_dif+j)));
+        r = _mm512_add_pd(r, _mm512_mul_pd(va2, _mm512_loadu_pd(y+j)));
+        r = abs(_mm512_sub_pd(r, _mm512_loadu_pd(in+j)));
+        md = _mm512_add_pd(md, r);
+        rms = _mm512_add_pd(rms, _mm512_mul_pd(r, r));
+      }
+      MisfitSums sums;
+      sums.md = hsum(md);
+      sums.rms = hsum(rms);
+      for (; j<n; ++j)
+      {
+        double const r = fabs(y_dif2[j] + a1*y_dif[j] + a2*y[j] - in[j]);
+        sums.md += r;
+        sums.rms += r*r;
+      }
+      return sums;
+    } // function linear
+
+    /* --------------------------------------------------------------------- */
+    __attribute__((target("avx512f")))
+    MisfitSums nonlinear(double const* in, double const* y_dif2,
+        double const* y_dif, double const* y, double const* y_square,
+        double const* y_cube, int n, double a1, double a2, double c0,
+        double c1)
+    {
+      __m512d const va1 = _mm512_set1_pd(a1);
+      __m512d const va2 = _mm512_set1_pd(a2);
+      __m512d const vc0 = _mm512_set1_pd(c0);
+      __m512d const vc1 = _mm512_set1_pd(c1);
+      __m512d md = _mm512_setzero_pd();
+      __m512d rms = _mm512_setzero_pd();
+      int j = 0;
+      for (; j+8<=n; j+=8)
+      {
+        __m512d r = _mm512_add_pd(_mm512_loadu_pd(y_dif2+j),
+            _mm512_mul_pd(va1, _mm512_loadu_pd(y_dif+j)));
+        r = _mm512_add_pd(r, _mm512_mul_pd(va2, _mm512_loadu_pd(y+j)));
+        r = _mm512_add_pd(r, _mm512_mul_pd(vc0, _mm512_loadu_pd(y_square+j)));
+        r = _mm512_add_pd(r, _mm512_mul_pd(vc1, _mm512_loadu_pd(y_cube+j)));
+        r = abs(_mm512_sub_pd(r, _mm512_loadu_pd(in+j)));
+        md = _mm512_add_pd(md, r);
+        rms = _mm512_add_pd(rms, _mm512_mul_pd(r, r));
+      }
+      MisfitSums sums;
+      sums.md = hsum(md);
+      sums.rms = hsum(rms);
+      for (; j<n; ++j)
+      {
+        double const r = fabs(y_dif2[j] + a1*y_dif[j] + a2*y[j] +
+            c0*y_square[j] + c1*y_cube[j] - in[j]);
+        sums.md += r;
+        sums.rms += r*r;
+      }
+      return sums;
+    } // function nonlinear
+
+  } // namespace avx512
+
+} // namespace kernel
+
+#endif // OPTNONLIN_X86_KERNELS
+
+/* ----- END OF simd.cc  ----- */
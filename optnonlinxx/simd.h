@@ -0,0 +1,93 @@
+/*! \file simd.h
+ * \brief Declaration of the vectorized misfit kernels of optnonlin.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Declaration of the vectorized misfit kernels of optnonlin. Each
+ * instruction set extension has its own namespace. The functions are
+ * compiled for their target with function attributes so the binary itself
+ * does not depend on the CPU it was built on. They must only be called if
+ * kernel::supported() is true for the corresponding instruction set.
+ *
+ * This header is internal to the kernel implementation. Use the dispatching
+ * functions declared in kernel.h.
+ *
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  AVX2 single precision kernels
+ *
+ * ============================================================================
+ */
+
+#include "kernel.h"
+
+#ifndef _OPTNONLIN_SIMD_H_
+#define _OPTNONLIN_SIMD_H_
+
+#if defined(__x86_64__) || defined(__i386__)
+#define OPTNONLIN_X86_KERNELS
+#endif
+
+#ifdef OPTNONLIN_X86_KERNELS
+
+/*! declare the kernels of one instruction set extension */
+#define OPTNONLIN_DECLARE_KERNELS(isa) \
+  namespace isa \
+  { \
+    MisfitSums norms(double const* in, int n); \
+    MisfitSums linear(double const* in, double const* y_dif2, \
+        double const* y_dif, double const* y, int n, double a1, double a2); \
+    MisfitSums nonlinear(double const* in, double const* y_dif2, \
+        double const* y_dif, double const* y, double const* y_square, \
+        double const* y_cube, int n, double a1, double a2, double c0, \
+        double c1); \
+  }
+
+namespace kernel
+{
+  OPTNONLIN_DECLARE_KERNELS(sse2)
+  OPTNONLIN_DECLARE_KERNELS(avx2)
+  OPTNONLIN_DECLARE_KERNELS(avx512)
+
+  namespace avx2
+  {
+    MisfitSums norms(float const* in, int n);
+    MisfitSums linear(float const* in, float const* y_dif2,
+        float const* y_dif, float const* y, int n, double a1, double a2);
+    MisfitSums nonlinear(float const* in, float const* y_dif2,
+        float const* y_dif, float const* y, float const* y_square,
+        float const* y_cube, int n, double a1, double a2, double c0,
+        double c1);
+  } // namespace avx2
+} // namespace kernel
+
+#undef OPTNONLIN_DECLARE_KERNELS
+
+#endif // OPTNONLIN_X86_KERNELS
+
+#endif // include guard
+
+/* ----- END OF simd.h  ----- */
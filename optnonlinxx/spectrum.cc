@@ -0,0 +1,165 @@
+/*! \file spectrum.cc
+ * \brief Implementation of the band limited Gram matrix computed from
+ * spectra.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Implementation of the band limited Gram matrix computed from
+ * spectra.
+ *
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <string>
+#include <cmath>
+#include <utility>
+#include "spectrum.h"
+
+namespace spectrum
+{
+
+  /* ----------------------------------------------------------------------- */
+  void fft(std::vector<std::complex<double> >& data)
+  {
+    size_t const n = data.size();
+    if (0 == n || 0 != (n & (n-1)))
+    {
+      throw std::string("FFT size is not a power of two.");
+    }
+    // bit reversal permutation
+    for (size_t i=1, j=0; i<n; ++i)
+    {
+      size_t bit = n >> 1;
+      for (; j & bit; bit >>= 1) { j ^= bit; }
+      j ^= bit;
+      if (i < j) { std::swap(data[i], data[j]); }
+    }
+    // butterflies
+    double const pi = 4.*atan(1.);
+    for (size_t len=2; len<=n; len <<= 1)
+    {
+      double const angle = -2.*pi/len;
+      std::complex<double> const step(cos(angle), sin(angle));
+      for (size_t i=0; i<n; i+=len)
+      {
+        std::complex<double> w(1.);
+        for (size_t k=0; k<len/2; ++k)
+        {
+          std::complex<double> const u = data[i+k];
+          std::complex<double> const v = data[i+k+len/2]*w;
+          data[i+k] = u+v;
+          data[i+k+len/2] = u-v;
+          // recompute the twiddle factor from time to time to limit the
+          // accumulation of rounding errors
+          w = (k+1) % 64 ? w*step :
+            std::complex<double>(cos(angle*(k+1)), sin(angle*(k+1)));
+        }
+      }
+    }
+  } // function fft
+
+  /* ----------------------------------------------------------------------- */
+  GramMatrix bandGram(std::vector<double const*> const& columns, int n,
+      double dt, double fmin, double fmax, size_t* bins)
+  {
+    int const k = columns.size();
+    if (0 == k || 0 >= n || 0 >= dt)
+    {
+      throw std::string("Spectra of empty time series requested.");
+    }
+    if (0 > fmin || fmin > fmax)
+    {
+      throw std::string("Illegal passband.");
+    }
+    size_t size = 1;
+    while (size < size_t(n)) { size <<= 1; }
+
+    // bins of the passband of the one-sided spectrum
+    size_t const first = static_cast<size_t>(ceil(fmin*size*dt));
+    size_t const last = std::min(size/2,
+        static_cast<size_t>(floor(fmax*size*dt)));
+    if (first > last) { throw std::string("Passband contains no bins."); }
+    if (bins) { *bins = last-first+1; }
+
+    // transform two real regressors at once: with z = x + iy the spectra
+    // are X_l = (Z_l + Z*_{N-l})/2 and Y_l = (Z_l - Z*_{N-l})/2i
+    std::vector<std::vector<std::complex<double> > > spectra(k);
+    std::vector<std::complex<double> > z(size);
+    for (int i=0; i<k; i+=2)
+    {
+      double const* x = columns[i];
+      double const* y = i+1 < k ? columns[i+1] : 0;
+      for (size_t l=0; l<size; ++l)
+      {
+        z[l] = l < size_t(n) ?
+          std::complex<double>(x[l], y ? y[l] : 0.) : 0.;
+      }
+      fft(z);
+      spectra[i].resize(last-first+1);
+      if (y) { spectra[i+1].resize(last-first+1); }
+      for (size_t l=first; l<=last; ++l)
+      {
+        std::complex<double> const zl = z[l];
+        std::complex<double> const zm = std::conj(z[(size-l) % size]);
+        spectra[i][l-first] = 0.5*(zl+zm);
+        if (y)
+        {
+          spectra[i+1][l-first] =
+            std::complex<double>(0., -0.5)*(zl-zm);
+        }
+      }
+    }
+
+    // inner products; bins other than zero and Nyquist frequency represent
+    // their negative frequency counterpart as well
+    std::vector<long double> data(k*k, 0.L);
+    for (size_t l=first; l<=last; ++l)
+    {
+      long double const weight =
+        (0 == l || size/2 == l) ? 1.L/size : 2.L/size;
+      for (int i=0; i<k; ++i)
+      {
+        for (int m=i; m<k; ++m)
+        {
+          data[i*k+m] += weight*(std::real(spectra[i][l-first]*
+                std::conj(spectra[m][l-first])));
+        }
+      }
+    }
+    for (int i=0; i<k; ++i)
+    {
+      for (int m=0; m<i; ++m) { data[i*k+m] = data[m*k+i]; }
+    }
+    return GramMatrix(k, data);
+  } // function bandGram
+
+} // namespace spectrum
+
+/* ----- END OF spectrum.cc  ----- */
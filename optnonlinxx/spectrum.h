@@ -0,0 +1,82 @@
+/*! \file spectrum.h
+ * \brief Declaration of the band limited Gram matrix computed from spectra.
+ *
+ * ----------------------------------------------------------------------------
+ *
+ * $Id$
+ * \author Daniel Armbruster
+ * \date 16/10/2026
+ *
+ * Purpose: Declaration of the band limited Gram matrix computed from spectra.
+ * Due to Parseval's theorem the inner product of two time series equals
+ * the inner product of their discrete Fourier transforms. Restricting the
+ * latter to a passband yields the inner products of the bandpass filtered
+ * time series. Thus the frequency domain misfit of a node is evaluated
+ * from a Gram matrix as well.
+ *
+
+ * ----
+ * This file is part of optnonlin.
+ *
+ * optnonlin is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * optnonlin is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with optnonlin.  If not, see <http://www.gnu.org/licenses/>.
+ * ----
+ *
+ * Copyright (c) 2012 by Daniel Armbruster
+ *
+ * REVISIONS and CHANGES
+ * 16/10/2026  V0.1  Daniel Armbruster
+ *
+ * ============================================================================
+ */
+
+#include <vector>
+#include <complex>
+#include "gram.h"
+
+#ifndef _OPTNONLIN_SPECTRUM_H_
+#define _OPTNONLIN_SPECTRUM_H_
+
+namespace spectrum
+{
+  /*!
+   * in-place radix-2 fast Fourier transform
+   *
+   * \param data samples; the size must be a power of two
+   */
+  void fft(std::vector<std::complex<double> >& data);
+
+  /*!
+   * compute the Gram matrix of bandpass filtered regressors
+   *
+   * The regressors are padded with zeros to the next power of two and
+   * transformed pairwise by a single complex transform. Only the bins of
+   * the passband are kept. With \a fmin zero and \a fmax at least the
+   * Nyquist frequency the result equals the Gram matrix of the time series
+   * up to rounding errors.
+   *
+   * \param columns pointers to the first sample of each regressor
+   * \param n number of samples of each regressor
+   * \param dt sampling interval
+   * \param fmin lower corner frequency of the passband in Hz
+   * \param fmax upper corner frequency of the passband in Hz
+   * \param bins if not 0 the number of bins of the passband is stored here
+   */
+  GramMatrix bandGram(std::vector<double const*> const& columns, int n,
+      double dt, double fmin, double fmax, size_t* bins=0);
+
+} // namespace spectrum
+
+#endif // include guard
+
+/* ----- END OF spectrum.h  ----- */
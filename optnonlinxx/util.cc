@@ -30,12 +30,17 @@
  * 
  * REVISIONS and CHANGES 
  * 19/04/2012  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  conversion of the sample type
+ * 16/10/2026  V0.3  decimation
+ * 16/10/2026  V0.4  derivatives: fix the last sample
  * 
  * ============================================================================
  */
 
 #include <string>
 #include <cmath>
+#include <vector>
+#include <algorithm>
 #include "util.h"
 
 namespace util
@@ -52,14 +57,12 @@ namespace util
 
     if (0 == time_constant) { time_constant = 1.; }
     double denominator = 2.*dt / time_constant;
-    int j;
-    for (j=series.f()+1; j<series.l(); ++j)
+    for (int j=series.f()+1; j<series.l(); ++j)
     {
       result_series(j) = (series(j+1)-series(j-1)) / denominator;
     }
-    result_series(0) = result_series(1);
-    ++j;
-    result_series(j) = result_series(j-1);
+    result_series(series.f()) = result_series(series.f()+1);
+    result_series(series.l()) = result_series(series.l()-1);
   } // function dif
 
   /* ----------------------------------------------------------------------- */
@@ -73,14 +76,12 @@ namespace util
 
     if (0 == time_constant) { time_constant = 1.; }
     double denominator = pow(dt,2.) / time_constant;
-    int j;
-    for (j=series.f()+1; j<series.l(); ++j)
+    for (int j=series.f()+1; j<series.l(); ++j)
     {
       result_series(j) = (series(j+1)-2*series(j)+series(j-1)) / denominator;
     }
-    result_series(0) = result_series(1);
-    ++j;
-    result_series(j) = result_series(j-1);
+    result_series(series.f()) = result_series(series.f()+1);
+    result_series(series.l()) = result_series(series.l()-1);
   } // function dif2
 
   /* ----------------------------------------------------------------------- */
@@ -124,6 +125,61 @@ namespace util
   } // function multiply
 
   /* ----------------------------------------------------------------------- */
+  template <typename Tvalue>
+  void convert(datrw::Tdseries const& series,
+      aff::Series<Tvalue>& result_series)
+  {
+    if (series.size() != result_series.size())
+    {
+      throw std::string("Inconsistant series size.");
+    }
+    for (int j=series.f(), k=result_series.f(); j<=series.l(); ++j, ++k)
+    {
+      result_series(k) = static_cast<Tvalue>(series(j));
+    }
+  } // function convert
+
+  template void convert<float>(datrw::Tdseries const&, aff::Series<float>&);
+  template void convert<double>(datrw::Tdseries const&, aff::Series<double>&);
+
+  /* ----------------------------------------------------------------------- */
+  void decimate(datrw::Tdseries const& series,
+      datrw::Tdseries& result_series, int factor)
+  {
+    if (1 > factor) { throw std::string("Illegal decimation factor."); }
+    if ((series.size()+factor-1)/factor != result_series.size())
+    {
+      throw std::string("Inconsistant series size.");
+    }
+
+    // filter coefficients normalized to unit gain at zero frequency
+    double const pi = 4.*atan(1.);
+    double const cutoff = 0.4/factor;
+    int const m = 4*factor;
+    std::vector<double> coefficients(2*m+1);
+    double sum = 0;
+    for (int k=-m; k<=m; ++k)
+    {
+      double const x = 2.*pi*cutoff*k;
+      double const window = 0.54+0.46*cos(pi*k/m);
+      coefficients[k+m] = window * (0 == k ? 1. : sin(x)/x);
+      sum += coefficients[k+m];
+    }
+
+    int const first = series.f();
+    int const last = series.l();
+    for (int j=first, i=result_series.f(); j<=last; j+=factor, ++i)
+    {
+      double value = 0;
+      for (int k=-m; k<=m; ++k)
+      {
+        value += coefficients[k+m]*series(std::min(last, std::max(first, j+k)));
+      }
+      result_series(i) = value / sum;
+    }
+  } // function decimate
+
+  /* ----------------------------------------------------------------------- */
 
 } // namespace util
 
@@ -30,6 +30,8 @@
  * 
  * REVISIONS and CHANGES 
  * 19/04/2012  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  conversion of the sample type
+ * 16/10/2026  V0.3  decimation
  * 
  * ============================================================================
  */
@@ -97,6 +99,33 @@ namespace util
   void multiply(datrw::Tdseries const& series, datrw::Tdseries& result_series,
       double fac);
 
+  /*!
+   * convert a time series into a time series of another sample type
+   *
+   * Instantiated for \c float and \c double.
+   *
+   * \param series input data
+   * \param result_series the result will be saved to this series
+   */
+  template <typename Tvalue>
+  void convert(datrw::Tdseries const& series,
+      aff::Series<Tvalue>& result_series);
+
+  /*!
+   * lowpass filter and decimate a time series
+   *
+   * The anti-alias filter is a Hamming windowed sinc filter with a cutoff
+   * at 80% of the Nyquist frequency of the decimated series. Samples beyond
+   * the ends are replaced by the first and last sample respectively.
+   *
+   * \param series input data
+   * \param result_series the result will be saved to this series; its size
+   * must be \f$\lceil n/factor\rceil\f$
+   * \param factor decimation factor
+   */
+  void decimate(datrw::Tdseries const& series,
+      datrw::Tdseries& result_series, int factor);
+
 } // namespace util
 
 #endif // include guard
@@ -32,6 +32,7 @@
  * 
  * REVISIONS and CHANGES 
  * 20/04/2012  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  logarithmic and list axes
  * 
  * ============================================================================
  */
@@ -39,6 +40,7 @@
 #include <sstream>
 #include <algorithm>
 #include <iterator>
+#include <cmath>
 #include "validator.h"
 
 namespace po = boost::program_options;
@@ -65,24 +67,67 @@ namespace
 namespace optimize
 {
   void validate(boost::any& v, const std::vector<std::string>& values,
-                StandardParameter<TcoordType>*, int)
+                std::shared_ptr<Parameter<TcoordType>>*, int)
   {
-
-    if (values.size() != 4)
+    // split the values at whitespace and semicolons
+    std::vector<std::string> tokens;
+    for (auto cit(values.cbegin()); cit != values.cend(); ++cit)
+    {
+      std::string str(*cit);
+      std::replace(str.begin(), str.end(), ';', ' ');
+      std::istringstream iss(str);
+      std::copy(std::istream_iterator<std::string>(iss),
+          std::istream_iterator<std::string>(), std::back_inserter(tokens));
+    }
+    if (tokens.size() < 3)
     {
       throw po::validation_error(po::validation_error::invalid_option_value);
     }
 
-    const std::string id = values.at(0);
+    const std::string id = tokens.at(0);
     if (("c0" != id) && ("c1" != id) && ("T0" != id) && ("h" != id))
     {
       throw po::validation_error(po::validation_error::invalid_option_value);
     }
+    std::string const type(tokens.at(1));
     std::vector<TcoordType> param_values;
-    std::transform(values.begin()+1, values.end(),
-        std::back_inserter(param_values), ::string2X);
-    v = boost::any(StandardParameter<TcoordType>(
-          id, param_values[0], param_values[1], param_values[2]));
+    std::transform(tokens.begin()+("log" == type || "list" == type ? 2 : 1),
+        tokens.end(), std::back_inserter(param_values), ::string2X);
+    try
+    {
+      if ("list" == type)
+      {
+        v = boost::any(std::shared_ptr<Parameter<TcoordType>>(
+              new ListParameter(id, param_values)));
+      } else
+      if ("log" == type)
+      {
+        // the number of nodes must be an integer of at least two
+        if (3 != param_values.size() || 2 > param_values[2] ||
+            param_values[2] != floor(param_values[2]))
+        {
+          throw po::validation_error(
+              po::validation_error::invalid_option_value);
+        }
+        v = boost::any(std::shared_ptr<Parameter<TcoordType>>(
+              new ListParameter(id, logarithmicAxis(param_values[0],
+                  param_values[1], static_cast<size_t>(param_values[2])))));
+      } else
+      if (3 == param_values.size())
+      {
+        v = boost::any(std::shared_ptr<Parameter<TcoordType>>(
+              new StandardParameter<TcoordType>(id, param_values[0],
+                param_values[1], param_values[2])));
+      } else
+      {
+        throw po::validation_error(
+            po::validation_error::invalid_option_value);
+      }
+    }
+    catch (std::string)
+    {
+      throw po::validation_error(po::validation_error::invalid_option_value);
+    }
   } // function validate
 }
 
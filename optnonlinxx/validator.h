@@ -32,15 +32,18 @@
  * 
  * REVISIONS and CHANGES 
  * 20/04/2012  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  logarithmic and list axes
  * 
  * ============================================================================
  */
 
 #include <vector>
 #include <string>
+#include <memory>
 #include <boost/program_options.hpp>
 #include <optimizexx/parameter.h>
 #include "types.h"
+#include "axis.h"
  
 #ifndef _OPTNONLIN_VALIDATOR_H_
 #define _OPTNONLIN_VALIDATOR_H_ 
@@ -54,13 +57,28 @@ namespace opt = optimize;
 namespace optimize
 {
   /*!
-   * custom validator for a \a liboptimizexx standard parameter for commandline
+   * custom validator for a \a liboptimizexx parameter for commandline
    * parsing using
    * <a href="http://www.boost.org/doc/libs/release/libs/program_options/">
    * Boost Program Options</a> library.
+   *
+   * The values are separated by whitespace or semicolons. The syntax is
+   * either
+   * \code
+   * id start end delta
+   * \endcode
+   * for a linear axis (standard parameter),
+   * \code
+   * id log start end n
+   * \endcode
+   * for \a n logarithmically spaced values or
+   * \code
+   * id list value [value ...]
+   * \endcode
+   * for an explicit list of values.
    */
   void validate(boost::any& v, const std::vector<std::string>& values,
-                StandardParameter<TcoordType>*, int);
+                std::shared_ptr<Parameter<TcoordType>>*, int);
 }
 
 #endif // include guard
@@ -32,118 +32,173 @@
  * 
  * REVISIONS and CHANGES 
  * 19/04/2012  V0.1  Daniel Armbruster
+ * 16/10/2026  V0.2  Make use of fused misfit kernels. No temporary time series
+ *                   are allocated anymore.
+ * 16/10/2026  V0.3  GramApplication added.
+ * 16/10/2026  V0.4  Batched evaluation of nodes.
+ * 16/10/2026  V0.5  Explicit instantiations for single and double precision
+ *                   time series.
+ * 16/10/2026  V0.6  Coordinates are looked up by parameter id.
+ *                   ModelApplication added.
+ * 16/10/2026  V0.7  ProjectionApplication added.
+ * 16/10/2026  V0.8  Pruning of nodes in batched evaluation.
  * 
  * ============================================================================
  */
  
 #include <iostream>
 #include <iomanip>
+#include <sstream>
 #include <vector>
+#include <limits>
+#include <algorithm>
 #include "visitor.h"
 #include "util.h"
 #include "result.h"
 #include "types.h"
+#include "kernel.h"
+#include "model.h"
+#include "prune.h"
 
 /* -------------------------------------------------------------------------- */
-void LinApplication::operator()(opt::Node<TcoordType, TresultType>* node)
+template <typename Tvalue>
+void BasicLinApplication<Tvalue>::operator()(opt::Node<TcoordType, TresultType>* node)
 {
   std::vector<TcoordType> const& coordinates = node->getCoordinates();
-  
-  datrw::Tdseries factorTimesMyDif(McalibInSeries.size());
-  datrw::Tdseries factorTimesMy(McalibInSeries.size());
-
-  // h  -> coordinates[0]
-  // T0 -> coordinates[1]
-  // multiply series with appropriate factor
-  util::multiply(MyDif, factorTimesMyDif,
-      ((2*Mpi)/coordinates[1])*coordinates[0]);
-  util::multiply(My, factorTimesMy, (4.*pow(Mpi, 2.))/coordinates[1]);
-
-  datrw::Tdseries differenceSeries(McalibInSeries.size()); 
-  // compute difference of series
-  for (int j=MyDif2.f(); j<=MyDif2.l(); ++j)
-  {
-    differenceSeries(j) = fabs(MyDif2(j) + factorTimesMyDif(j) +
-          factorTimesMy(j) - McalibInSeries(j));
-  }
-  // compute square of difference of series
-  double md_numerator = 0;
-  double md_denominator = 0;
-  double rms_numerator = 0;
-  double rms_denominator = 0;
-  for (int j=differenceSeries.f(); j<=differenceSeries.l(); ++j)
-  {
-    md_numerator += differenceSeries(j);
-    rms_numerator += pow(differenceSeries(j), 2.);
-    md_denominator += fabs(McalibInSeries(j));
-    rms_denominator += pow(McalibInSeries(j), 2.);
-  }
-
-  TresultType result(md_numerator / md_denominator, 
-      sqrt(rms_numerator / rms_denominator));
+
+  kernel::MisfitSums sums = kernel::linear(kernel::samples(McalibInSeries),
+      kernel::samples(MyDif2), kernel::samples(MyDif), kernel::samples(My),
+      McalibInSeries.size(), ((2*Mpi)/coordinates[MT0])*coordinates[Mh],
+      (4.*pow(Mpi, 2.))/coordinates[MT0]);
+
+  finish(node, sums);
+} // function BasicLinApplication::operator()
+
+/* -------------------------------------------------------------------------- */
+template <typename Tvalue>
+void BasicLinApplication<Tvalue>::visitBatch(TnodeType* const* nodes, int count)
+{
+  std::vector<double> a1(count), a2(count);
+  std::vector<kernel::MisfitSums> sums(count);
+  for (int i=0; i<count; ++i)
+  {
+    std::vector<TcoordType> const& coordinates = nodes[i]->getCoordinates();
+    a1[i] = ((2*Mpi)/coordinates[MT0])*coordinates[Mh];
+    a2[i] = (4.*pow(Mpi, 2.))/coordinates[MT0];
+  }
+
+  if (Mpruning)
+  {
+    std::vector<bool> pruned;
+    accumulatePruned(McalibInSeries.size(), count,
+        [&](int i, int j, int len) -> kernel::MisfitSums
+        {
+          return kernel::linear(kernel::samples(McalibInSeries)+j,
+            kernel::samples(MyDif2)+j, kernel::samples(MyDif)+j,
+            kernel::samples(My)+j, len, a1[i], a2[i]);
+        }, Mnorms.rms, *Mpruning, sums, pruned);
+    for (int i=0; i<count; ++i) { finish(nodes[i], sums[i], pruned[i]); }
+    return;
+  }
+
+  kernel::linearBatch(kernel::samples(McalibInSeries),
+      kernel::samples(MyDif2), kernel::samples(MyDif), kernel::samples(My),
+      McalibInSeries.size(), count, &a1[0], &a2[0], &sums[0]);
+
+  for (int i=0; i<count; ++i) { finish(nodes[i], sums[i]); }
+} // function BasicLinApplication::visitBatch
+
+/* -------------------------------------------------------------------------- */
+template <typename Tvalue>
+void BasicLinApplication<Tvalue>::finish(TnodeType* node,
+    kernel::MisfitSums const& sums, bool pruned) const
+{
+  TresultType result(sums.md / Mnorms.md, sqrt(sums.rms / Mnorms.rms),
+      pruned);
   node->setResultData(result);
   node->setComputed();
+  if (Mpruning && ! pruned) { Mpruning->offer(result.getRmsMisfit()); }
 
   if (Mverbose) 
   { 
+    std::vector<TcoordType> const& coordinates = node->getCoordinates();
     // without loop cause if using multiple threads to avoid mixing output up
     std::cout << "Parameter configuration: "
       << std::setw(12) << std::fixed << std::right << coordinates[0] << " "
       << std::setw(12) << std::fixed << std::right << coordinates[1]
       << "\nResult: " << result << std::endl;
   }
-} // function LinApplication::operator()
+} // function BasicLinApplication::finish
 
 /* -------------------------------------------------------------------------- */
-void NonLinApplication::operator()(opt::Node<TcoordType, TresultType>* node)
+template <typename Tvalue>
+void BasicNonLinApplication<Tvalue>::operator()(opt::Node<TcoordType, TresultType>* node)
 {
   std::vector<TcoordType> const& coordinates = node->getCoordinates();
 
-  
-  datrw::Tdseries factorTimesMyDif(McalibInSeries.size());
-  datrw::Tdseries factorTimesMy(McalibInSeries.size());
-  datrw::Tdseries c0TimesMySquare(McalibInSeries.size());
-  datrw::Tdseries c1TimesMyCube(McalibInSeries.size());
-
-  // multiply series with approriate coordinate factor
-  // c0 -> coordinates[0]
-  // c1 -> coordinates[1]
-  // h  -> coordinates[2]
-  // T0 -> coordinates[3]
-  util::multiply(MyDif, factorTimesMyDif,
-      ((2*Mpi)/coordinates[3])*coordinates[2]);
-  util::multiply(My, factorTimesMy, (4.*pow(Mpi, 2.))/coordinates[3]);
-  util::multiply(MySquare, c0TimesMySquare, coordinates[0]);
-  util::multiply(MyCube, c1TimesMyCube, coordinates[1]);
-
-  datrw::Tdseries differenceSeries(McalibInSeries.size()); 
-  // compute difference of series
-  for (int j=MyDif2.f(); j<=MyDif2.l(); ++j)
-  {
-    differenceSeries(j) = fabs(MyDif2(j) + factorTimesMyDif(j) +
-          factorTimesMy(j) + c0TimesMySquare(j) + c1TimesMyCube(j) -
-          McalibInSeries(j));
-  }
-  // compute square of difference of series
-  double md_numerator = 0;
-  double md_denominator = 0;
-  double rms_numerator = 0;
-  double rms_denominator = 0;
-  for (int j=differenceSeries.f(); j<=differenceSeries.l(); ++j)
-  {
-    md_numerator += differenceSeries(j);
-    rms_numerator += pow(differenceSeries(j), 2.);
-    md_denominator += fabs(McalibInSeries(j));
-    rms_denominator += pow(McalibInSeries(j), 2.);
-  }
-
-  TresultType result(md_numerator / md_denominator, 
-      sqrt(rms_numerator / rms_denominator));
+  kernel::MisfitSums sums = kernel::nonlinear(
+      kernel::samples(McalibInSeries), kernel::samples(MyDif2),
+      kernel::samples(MyDif), kernel::samples(My), kernel::samples(MySquare),
+      kernel::samples(MyCube), McalibInSeries.size(),
+      ((2*Mpi)/coordinates[MT0])*coordinates[Mh],
+      (4.*pow(Mpi, 2.))/coordinates[MT0], coordinates[Mc0], coordinates[Mc1]);
+
+  finish(node, sums);
+} // function BasicNonLinApplication::operator()
+
+/* -------------------------------------------------------------------------- */
+template <typename Tvalue>
+void BasicNonLinApplication<Tvalue>::visitBatch(TnodeType* const* nodes, int count)
+{
+  std::vector<double> a1(count), a2(count), c0(count), c1(count);
+  std::vector<kernel::MisfitSums> sums(count);
+  for (int i=0; i<count; ++i)
+  {
+    std::vector<TcoordType> const& coordinates = nodes[i]->getCoordinates();
+    a1[i] = ((2*Mpi)/coordinates[MT0])*coordinates[Mh];
+    a2[i] = (4.*pow(Mpi, 2.))/coordinates[MT0];
+    c0[i] = coordinates[Mc0];
+    c1[i] = coordinates[Mc1];
+  }
+
+  if (Mpruning)
+  {
+    std::vector<bool> pruned;
+    accumulatePruned(McalibInSeries.size(), count,
+        [&](int i, int j, int len) -> kernel::MisfitSums
+        {
+          return kernel::nonlinear(kernel::samples(McalibInSeries)+j,
+            kernel::samples(MyDif2)+j, kernel::samples(MyDif)+j,
+            kernel::samples(My)+j, kernel::samples(MySquare)+j,
+            kernel::samples(MyCube)+j, len, a1[i], a2[i], c0[i], c1[i]);
+        }, Mnorms.rms, *Mpruning, sums, pruned);
+    for (int i=0; i<count; ++i) { finish(nodes[i], sums[i], pruned[i]); }
+    return;
+  }
+
+  kernel::nonlinearBatch(kernel::samples(McalibInSeries),
+      kernel::samples(MyDif2), kernel::samples(MyDif), kernel::samples(My),
+      kernel::samples(MySquare), kernel::samples(MyCube),
+      McalibInSeries.size(), count, &a1[0], &a2[0], &c0[0], &c1[0],
+      &sums[0]);
+
+  for (int i=0; i<count; ++i) { finish(nodes[i], sums[i]); }
+} // function BasicNonLinApplication::visitBatch
+
+/* -------------------------------------------------------------------------- */
+template <typename Tvalue>
+void BasicNonLinApplication<Tvalue>::finish(TnodeType* node,
+    kernel::MisfitSums const& sums, bool pruned) const
+{
+  TresultType result(sums.md / Mnorms.md, sqrt(sums.rms / Mnorms.rms),
+      pruned);
   node->setResultData(result);
   node->setComputed();
+  if (Mpruning && ! pruned) { Mpruning->offer(result.getRmsMisfit()); }
 
   if (Mverbose) 
   { 
+    std::vector<TcoordType> const& coordinates = node->getCoordinates();
     // without loop cause if using multiple threads to avoid mixing output up
     std::cout << "Parameter configuration: "
       << std::setw(12) << std::fixed << std::right << coordinates[0] << " "
@@ -152,7 +207,285 @@ void NonLinApplication::operator()(opt::Node<TcoordType, TresultType>* node)
       << std::setw(12) << std::fixed << std::right << coordinates[3]
       << "\nResult: " << result << std::endl;
   }
-} // function NonLinApplication::operator()
+} // function BasicNonLinApplication::finish
+
+/* -------------------------------------------------------------------------- */
+// explicit instantiations
+template class BasicLinApplication<double>;
+template class BasicLinApplication<float>;
+template class BasicNonLinApplication<double>;
+template class BasicNonLinApplication<float>;
+
+/* -------------------------------------------------------------------------- */
+template <typename TModel, typename Tvalue>
+ModelApplication<TModel, Tvalue>::ModelApplication(
+    Tseries const& calib_in_series, Tseries const& y_dif2,
+    Tseries const& y_dif, Tseries const& y, CoordinateMap const& coordinates,
+    bool verbose) :
+  McalibInSeries(calib_in_series), MyDif2(y_dif2), MyDif(y_dif), My(y),
+  Mh(coordinates["h"]), MT0(coordinates["T0"]), Mpi(4.*atan(1.)),
+  Mpruning(0), Mverbose(verbose)
+{
+  if (McalibInSeries.size() != MyDif2.size() || 
+      McalibInSeries.size() != MyDif.size() ||
+      McalibInSeries.size() != My.size())
+  {
+    throw std::string("Inconsistent length of time series.");
+  }
+  for (int i=0; i<TModel::size; ++i)
+  {
+    Mc.push_back(coordinates[model::coefficientId(i)]);
+  }
+  Mnorms = kernel::norms(kernel::samples(McalibInSeries),
+      McalibInSeries.size());
+} // constructor ModelApplication
+
+/* -------------------------------------------------------------------------- */
+template <typename TModel, typename Tvalue>
+void ModelApplication<TModel, Tvalue>::coefficients(TnodeType const* node,
+    double& a1, double& a2, double* c) const
+{
+  std::vector<TcoordType> const& coordinates = node->getCoordinates();
+  a1 = ((2*Mpi)/coordinates[MT0])*coordinates[Mh];
+  a2 = (4.*pow(Mpi, 2.))/coordinates[MT0];
+  for (int i=0; i<TModel::size; ++i) { c[i] = coordinates[Mc[i]]; }
+} // function ModelApplication::coefficients
+
+/* -------------------------------------------------------------------------- */
+template <typename TModel, typename Tvalue>
+void ModelApplication<TModel, Tvalue>::operator()(
+    opt::Node<TcoordType, TresultType>* node)
+{
+  double a1, a2;
+  double c[TModel::size+1];
+  coefficients(node, a1, a2, c);
+  kernel::MisfitSums sums = TModel::misfit(kernel::samples(McalibInSeries),
+      kernel::samples(MyDif2), kernel::samples(MyDif), kernel::samples(My),
+      McalibInSeries.size(), a1, a2, c);
+
+  finish(node, sums);
+} // function ModelApplication::operator()
+
+/* -------------------------------------------------------------------------- */
+template <typename TModel, typename Tvalue>
+void ModelApplication<TModel, Tvalue>::visitBatch(TnodeType* const* nodes,
+    int count)
+{
+  int const stride = TModel::size+1;
+  std::vector<double> a1(count), a2(count), c(count*stride);
+  std::vector<kernel::MisfitSums> sums(count);
+  for (int i=0; i<count; ++i)
+  {
+    coefficients(nodes[i], a1[i], a2[i], &c[i*stride]);
+  }
+
+  if (Mpruning)
+  {
+    std::vector<bool> pruned;
+    accumulatePruned(McalibInSeries.size(), count,
+        [&](int i, int j, int len) -> kernel::MisfitSums
+        {
+          return TModel::misfit(kernel::samples(McalibInSeries)+j,
+            kernel::samples(MyDif2)+j, kernel::samples(MyDif)+j,
+            kernel::samples(My)+j, len, a1[i], a2[i], &c[i*stride]);
+        }, Mnorms.rms, *Mpruning, sums, pruned);
+    for (int i=0; i<count; ++i) { finish(nodes[i], sums[i], pruned[i]); }
+    return;
+  }
+
+  int const n = McalibInSeries.size();
+  for (int j=0; j<n; j+=kernel::tileSize)
+  {
+    int const len = std::min(kernel::tileSize, n-j);
+    for (int i=0; i<count; ++i)
+    {
+      kernel::MisfitSums const tile = TModel::misfit(
+          kernel::samples(McalibInSeries)+j, kernel::samples(MyDif2)+j,
+          kernel::samples(MyDif)+j, kernel::samples(My)+j, len, a1[i],
+          a2[i], &c[i*stride]);
+      sums[i].md += tile.md;
+      sums[i].rms += tile.rms;
+    }
+  }
+
+  for (int i=0; i<count; ++i) { finish(nodes[i], sums[i]); }
+} // function ModelApplication::visitBatch
+
+/* -------------------------------------------------------------------------- */
+template <typename TModel, typename Tvalue>
+void ModelApplication<TModel, Tvalue>::finish(TnodeType* node,
+    kernel::MisfitSums const& sums, bool pruned) const
+{
+  TresultType result(sums.md / Mnorms.md, sqrt(sums.rms / Mnorms.rms),
+      pruned);
+  node->setResultData(result);
+  node->setComputed();
+  if (Mpruning && ! pruned) { Mpruning->offer(result.getRmsMisfit()); }
+
+  if (Mverbose) 
+  { 
+    std::vector<TcoordType> const& coordinates = node->getCoordinates();
+    // collect output first cause if using multiple threads to avoid mixing
+    // output up
+    std::ostringstream oss;
+    oss << "Parameter configuration: ";
+    for (std::vector<TcoordType>::const_iterator cit(coordinates.begin());
+        cit != coordinates.end(); ++cit)
+    {
+      oss << std::setw(12) << std::fixed << std::right << *cit << " ";
+    }
+    oss << "\nResult: " << result;
+    std::cout << oss.str() << std::endl;
+  }
+} // function ModelApplication::finish
+
+/* -------------------------------------------------------------------------- */
+// explicit instantiations of the models selectable at runtime
+template class ModelApplication<model::LinearModel, double>;
+template class ModelApplication<model::LinearModel, float>;
+template class ModelApplication<model::CubicModel, double>;
+template class ModelApplication<model::CubicModel, float>;
+template class ModelApplication<model::QuadraticDampingModel, double>;
+template class ModelApplication<model::QuadraticDampingModel, float>;
+template class ModelApplication<model::OddModel, double>;
+template class ModelApplication<model::OddModel, float>;
+template class ModelApplication<model::ProductModel, double>;
+template class ModelApplication<model::ProductModel, float>;
+
+/* -------------------------------------------------------------------------- */
+GramApplication::GramApplication(GramMatrix const& gram,
+    CoordinateMap const& coordinates, int terms, bool verbose) :
+  Mgram(gram), Mh(coordinates["h"]), MT0(coordinates["T0"]),
+  Mpi(4.*atan(1.)), Mverbose(verbose)
+{
+  if (4+terms != Mgram.size())
+  {
+    throw std::string("Inconsistent number of regressors.");
+  }
+  if (Mgram.size() > MmaxRegressors)
+  {
+    throw std::string("Too many regressors.");
+  }
+  for (int i=0; i<terms; ++i)
+  {
+    Mc.push_back(coordinates[model::coefficientId(i)]);
+  }
+} // constructor GramApplication
+
+/* -------------------------------------------------------------------------- */
+void GramApplication::operator()(opt::Node<TcoordType, TresultType>* node)
+{
+  std::vector<TcoordType> const& coordinates = node->getCoordinates();
 
+  double coefficients[MmaxRegressors];
+  int const k = Mgram.size();
+  coefficients[0] = 1.;
+  coefficients[1] = ((2*Mpi)/coordinates[MT0])*coordinates[Mh];
+  coefficients[2] = (4.*pow(Mpi, 2.))/coordinates[MT0];
+  for (size_t i=0; i<Mc.size(); ++i)
+  {
+    coefficients[3+i] = coordinates[Mc[i]];
+  }
+  coefficients[k-1] = -1.;
+
+  TresultType result(std::numeric_limits<double>::quiet_NaN(),
+      sqrt(Mgram.quadraticForm(coefficients) / Mgram(k-1, k-1)));
+  node->setResultData(result);
+  node->setComputed();
+
+  if (Mverbose) 
+  { 
+    // collect output first cause if using multiple threads to avoid mixing
+    // output up
+    std::ostringstream oss;
+    oss << "Parameter configuration: ";
+    for (std::vector<TcoordType>::const_iterator cit(coordinates.begin());
+        cit != coordinates.end(); ++cit)
+    {
+      oss << std::setw(12) << std::fixed << std::right << *cit << " ";
+    }
+    oss << "\nResult: " << result;
+    std::cout << oss.str() << std::endl;
+  }
+} // function GramApplication::operator()
+
+
+/* -------------------------------------------------------------------------- */
+ProjectionApplication::ProjectionApplication(GramMatrix const& gram,
+    std::vector<double const*> const& columns, int n,
+    CoordinateMap const& coordinates, int terms, bool gain, bool md,
+    bool verbose) :
+  Mgram(gram), Mcolumns(columns), Mn(n), Mgain(gain), Mmd(md), MmdNorm(0),
+  Mh(coordinates["h"]), MT0(coordinates["T0"]), Mpi(4.*atan(1.)),
+  Mverbose(verbose)
+{
+  if (4+terms != Mgram.size() || Mgram.size() != int(Mcolumns.size()))
+  {
+    throw std::string("Inconsistent number of regressors.");
+  }
+  if (Mgram.size() > MmaxRegressors)
+  {
+    throw std::string("Too many regressors.");
+  }
+  for (int i=0; i<terms; ++i) { Mfree.push_back(3+i); }
+  if (Mgain) { Mfree.push_back(3+terms); }
+  if (Mmd)
+  {
+    MmdNorm = kernel::norms(Mcolumns.back(), Mn).md;
+  }
+} // constructor ProjectionApplication
+
+/* -------------------------------------------------------------------------- */
+void ProjectionApplication::operator()(
+    opt::Node<TcoordType, TresultType>* node)
+{
+  std::vector<TcoordType> const& coordinates = node->getCoordinates();
+
+  double coefficients[MmaxRegressors];
+  int const k = Mgram.size();
+  coefficients[0] = 1.;
+  coefficients[1] = ((2*Mpi)/coordinates[MT0])*coordinates[Mh];
+  coefficients[2] = (4.*pow(Mpi, 2.))/coordinates[MT0];
+  for (int i=3; i<k-1; ++i) { coefficients[i] = 0.; }
+  coefficients[k-1] = -1.;
+
+  double const sum = Mgram.minimize(coefficients, Mfree);
+
+  // the regressor of the calibration signal enters with -g
+  std::vector<double> parameters(coefficients+3, coefficients+k-1);
+  if (Mgain) { parameters.push_back(-coefficients[k-1]); }
+
+  double md = std::numeric_limits<double>::quiet_NaN();
+  if (Mmd)
+  {
+    md = 0;
+    for (int l=0; l<Mn; ++l)
+    {
+      double r = 0;
+      for (int i=0; i<k; ++i) { r += coefficients[i]*Mcolumns[i][l]; }
+      md += fabs(r);
+    }
+    md /= MmdNorm;
+  }
+
+  TresultType result(md, sqrt(sum / Mgram(k-1, k-1)), parameters);
+  node->setResultData(result);
+  node->setComputed();
+
+  if (Mverbose) 
+  { 
+    // collect output first cause if using multiple threads to avoid mixing
+    // output up
+    std::ostringstream oss;
+    oss << "Parameter configuration: ";
+    for (std::vector<TcoordType>::const_iterator cit(coordinates.begin());
+        cit != coordinates.end(); ++cit)
+    {
+      oss << std::setw(12) << std::fixed << std::right << *cit << " ";
+    }
+    oss << "\nResult: " << result;
+    std::cout << oss.str() << std::endl;
+  }
+} // function ProjectionApplication::operator()
 
 /* ----- END OF visitor.cc  ----- */
@@ -31,15 +31,29 @@
  * REVISIONS and CHANGES 
  * 19/04/2012   V0.1    Daniel Armbruster
  * 02/05/2012   V0.1.1  Corrections and adjustments of seismometer models.
+ * 16/10/2026   V0.2    Denominators of the misfit are computed once.
+ * 16/10/2026   V0.3    Provide GramApplication.
+ * 16/10/2026   V0.4    Batched evaluation of nodes.
+ * 16/10/2026   V0.5    Visitors of the direct evaluation are templates of the
+ *                      sample type.
+ * 16/10/2026   V0.6    Coordinates are looked up by parameter id. Provide
+ *                      ModelApplication.
+ * 16/10/2026   V0.7    Provide ProjectionApplication.
+ * 16/10/2026   V0.8    Pruning of nodes in batched evaluation.
  * 
  * ============================================================================
  */
  
 #include <cmath>
+#include <vector>
 #include <optimizexx/application.h>
 #include <optimizexx/node.h>
 #include <datrwxx/types.h>
 #include "types.h"
+#include "kernel.h"
+#include "gram.h"
+#include "batch.h"
+#include "coordinates.h"
 
 #ifndef _OPTNONLIN_VISITOR_H_
 #define _OPTNONLIN_VISITOR_H_
@@ -48,17 +62,24 @@ namespace opt = optimize;
 /*!
  * \a liboptimizexx parameter space visitor which acutally is the forward
  * algorithm of the linear model optimization for a seismometer.
+ *
+ * \tparam Tvalue sample type of the time series (\c double or \c float)
  */
-class LinApplication :
-  public opt::ParameterSpaceVisitor<TcoordType, TresultType>
+template <typename Tvalue>
+class BasicLinApplication :
+  public opt::ParameterSpaceVisitor<TcoordType, TresultType>,
+  public BatchVisitor
 {
   public:
+    //! type of the time series
+    typedef aff::Series<Tvalue> Tseries;
     //! constructor
-    LinApplication(datrw::Tdseries const& calib_in_series, 
-        datrw::Tdseries const& y_dif2, datrw::Tdseries const& y_dif,
-        datrw::Tdseries const& y, bool verbose=false) :
+    BasicLinApplication(Tseries const& calib_in_series, 
+        Tseries const& y_dif2, Tseries const& y_dif, Tseries const& y,
+        CoordinateMap const& coordinates, bool verbose=false) :
       McalibInSeries(calib_in_series), MyDif2(y_dif2), MyDif(y_dif), My(y),
-      Mpi(4.*atan(1.)), Mverbose(verbose)
+      Mh(coordinates["h"]), MT0(coordinates["T0"]), Mpi(4.*atan(1.)),
+      Mpruning(0), Mverbose(verbose)
     { 
       if (McalibInSeries.size() != MyDif2.size() || 
           McalibInSeries.size() != MyDif.size() ||
@@ -66,6 +87,8 @@ class LinApplication :
       {
         throw std::string("Inconsistent length of time series.");
       }
+      Mnorms = kernel::norms(kernel::samples(McalibInSeries),
+          McalibInSeries.size());
     }
     //! Visit function for a liboptimizexx grid.
     /*!
@@ -91,37 +114,75 @@ class LinApplication :
      * \param node Node to be visited.
      */
     virtual void operator()(opt::Node<TcoordType, TresultType>* node);
+    //! Batched application for a block of liboptimizexx nodes.
+    /*!
+     * Computes misfits equal to those of the per-node application up to
+     * rounding, since the sums are accumulated tile by tile. The time
+     * series are processed tile by tile and each tile is used for all nodes
+     * of the block.
+     *
+     * \param nodes pointer to the first node of the block
+     * \param count number of nodes in the block
+     */
+    virtual void visitBatch(TnodeType* const* nodes, int count);
+    //! abort nodes in batched evaluation which cannot be among the best
+    virtual void setPruning(TopKThreshold* threshold)
+    {
+      Mpruning = threshold;
+    }
   private:
+    //! store the result of a node and report it if verbose
+    void finish(TnodeType* node, kernel::MisfitSums const& sums,
+        bool pruned=false) const;
     //! time series containing the calibration signal
-    datrw::Tdseries const& McalibInSeries;
+    Tseries const& McalibInSeries;
     //! second derivative of the output time series of the seismometer
-    datrw::Tdseries const& MyDif2;
+    Tseries const& MyDif2;
     //! derivative of the output time series of the seismometer
-    datrw::Tdseries const& MyDif;
+    Tseries const& MyDif;
     //! output time series of the seismometer
-    datrw::Tdseries const& My;
+    Tseries const& My;
+    //! coordinate index of the damping
+    int const Mh;
+    //! coordinate index of the eigenperiod
+    int const MT0;
     // pi constant
     double const Mpi;
+    //! denominators of the MD and RMS misfit (independent of the node)
+    kernel::MisfitSums Mnorms;
+    //! shared bound of the pruning (0 if disabled)
+    TopKThreshold* Mpruning;
     //! verbosity flag
     bool Mverbose;
-}; // class LinApplication
+}; // class BasicLinApplication
+
+//! linear model application for double precision time series
+typedef BasicLinApplication<double> LinApplication;
 
 /* -------------------------------------------------------------------------- */
 /*!
  * \a liboptimizexx parameter space visitor which acutally is the forward
  * algorithm of the nonlinear model optimization.
+ *
+ * \tparam Tvalue sample type of the time series (\c double or \c float)
  */
-class NonLinApplication :
-  public opt::ParameterSpaceVisitor<TcoordType, TresultType>
+template <typename Tvalue>
+class BasicNonLinApplication :
+  public opt::ParameterSpaceVisitor<TcoordType, TresultType>,
+  public BatchVisitor
 {
   public:
+    //! type of the time series
+    typedef aff::Series<Tvalue> Tseries;
     //! constructor
-    NonLinApplication(datrw::Tdseries const& calib_in_series, 
-        datrw::Tdseries const& y_dif2, datrw::Tdseries const& y_dif,
-        datrw::Tdseries const& y, datrw::Tdseries const& y_square,
-        datrw::Tdseries const& y_cube, bool verbose=false) :
+    BasicNonLinApplication(Tseries const& calib_in_series, 
+        Tseries const& y_dif2, Tseries const& y_dif, Tseries const& y,
+        Tseries const& y_square, Tseries const& y_cube,
+        CoordinateMap const& coordinates, bool verbose=false) :
       McalibInSeries(calib_in_series), MyDif2(y_dif2), MyDif(y_dif), My(y),
-      MySquare(y_square), MyCube(y_cube), Mpi(4.*atan(1.)), Mverbose(verbose)
+      MySquare(y_square), MyCube(y_cube), Mc0(coordinates["c0"]),
+      Mc1(coordinates["c1"]), Mh(coordinates["h"]), MT0(coordinates["T0"]),
+      Mpi(4.*atan(1.)), Mpruning(0), Mverbose(verbose)
     { 
       if (McalibInSeries.size() != MyDif2.size() || 
           McalibInSeries.size() != MyDif.size() ||
@@ -131,6 +192,8 @@ class NonLinApplication :
       {
         throw std::string("Inconsistent length of time series.");
       }
+      Mnorms = kernel::norms(kernel::samples(McalibInSeries),
+          McalibInSeries.size());
     }
     //! Visit function for a liboptimizexx grid.
     /*!
@@ -156,25 +219,282 @@ class NonLinApplication :
      * \param node Node to be visited.
      */
     virtual void operator()(opt::Node<TcoordType, TresultType>* node);
+    //! Batched application for a block of liboptimizexx nodes.
+    /*!
+     * Computes misfits equal to those of the per-node application up to
+     * rounding, since the sums are accumulated tile by tile. The time
+     * series are processed tile by tile and each tile is used for all nodes
+     * of the block.
+     *
+     * \param nodes pointer to the first node of the block
+     * \param count number of nodes in the block
+     */
+    virtual void visitBatch(TnodeType* const* nodes, int count);
+    //! abort nodes in batched evaluation which cannot be among the best
+    virtual void setPruning(TopKThreshold* threshold)
+    {
+      Mpruning = threshold;
+    }
   private:
+    //! store the result of a node and report it if verbose
+    void finish(TnodeType* node, kernel::MisfitSums const& sums,
+        bool pruned=false) const;
     //! time series containing the calibration signal
-    datrw::Tdseries const& McalibInSeries;
+    Tseries const& McalibInSeries;
     //! second derivative of the output time series of the seismometer
-    datrw::Tdseries const& MyDif2;
+    Tseries const& MyDif2;
     //! derivative of the output time series of the seismometer
-    datrw::Tdseries const& MyDif;
+    Tseries const& MyDif;
     //! output time series of the seismometer
-    datrw::Tdseries const& My;
+    Tseries const& My;
     //! square of the output time series of the seismometer
-    datrw::Tdseries const& MySquare;
+    Tseries const& MySquare;
     //! cube of the output time series of the seismometer
-    datrw::Tdseries const& MyCube;
+    Tseries const& MyCube;
+    //! coordinate index of the coefficient of the square
+    int const Mc0;
+    //! coordinate index of the coefficient of the cube
+    int const Mc1;
+    //! coordinate index of the damping
+    int const Mh;
+    //! coordinate index of the eigenperiod
+    int const MT0;
+    // pi constant
+    double const Mpi;
+    //! denominators of the MD and RMS misfit (independent of the node)
+    kernel::MisfitSums Mnorms;
+    //! shared bound of the pruning (0 if disabled)
+    TopKThreshold* Mpruning;
+    //! verbosity flag
+    bool Mverbose;
+
+}; // class BasicNonLinApplication
+
+//! nonlinear model application for double precision time series
+typedef BasicNonLinApplication<double> NonLinApplication;
+
+/* -------------------------------------------------------------------------- */
+/*!
+ * \a liboptimizexx parameter space visitor which is the forward algorithm of
+ * an arbitrary model described by model::Model.
+ *
+ * The nonlinear terms of the model are evaluated on the fly, so only the
+ * time series of the linear model are read.
+ *
+ * \tparam TModel model type (see model.h)
+ * \tparam Tvalue sample type of the time series (\c double or \c float)
+ */
+template <typename TModel, typename Tvalue>
+class ModelApplication :
+  public opt::ParameterSpaceVisitor<TcoordType, TresultType>,
+  public BatchVisitor
+{
+  public:
+    //! type of the time series
+    typedef aff::Series<Tvalue> Tseries;
+    //! constructor
+    ModelApplication(Tseries const& calib_in_series, 
+        Tseries const& y_dif2, Tseries const& y_dif, Tseries const& y,
+        CoordinateMap const& coordinates, bool verbose=false);
+    //! Visit function for a liboptimizexx grid.
+    /*!
+     * Does nothing by default.
+     * Since a grid has no coordinates the body of this function is empty.
+     *
+     * \param grid Grid to be visited.
+     */
+    virtual void operator()(opt::Grid<TcoordType, TresultType>* grid) { }
+    //! Visit function / application for a liboptimizexx node.
+    /*!
+     * Computes the \f$MD\f$ and \f$RMS\f$ error of the model like
+     * NonLinApplication with the nonlinear terms of \a TModel.
+     *
+     * \param node Node to be visited.
+     */
+    virtual void operator()(opt::Node<TcoordType, TresultType>* node);
+    //! Batched application for a block of liboptimizexx nodes.
+    /*!
+     * \param nodes pointer to the first node of the block
+     * \param count number of nodes in the block
+     */
+    virtual void visitBatch(TnodeType* const* nodes, int count);
+    //! abort nodes in batched evaluation which cannot be among the best
+    virtual void setPruning(TopKThreshold* threshold)
+    {
+      Mpruning = threshold;
+    }
+  private:
+    //! model coefficients of a node
+    void coefficients(TnodeType const* node, double& a1, double& a2,
+        double* c) const;
+    //! store the result of a node and report it if verbose
+    void finish(TnodeType* node, kernel::MisfitSums const& sums,
+        bool pruned=false) const;
+    //! time series containing the calibration signal
+    Tseries const& McalibInSeries;
+    //! second derivative of the output time series of the seismometer
+    Tseries const& MyDif2;
+    //! derivative of the output time series of the seismometer
+    Tseries const& MyDif;
+    //! output time series of the seismometer
+    Tseries const& My;
+    //! coordinate indices of the coefficients of the nonlinear terms
+    std::vector<int> Mc;
+    //! coordinate index of the damping
+    int const Mh;
+    //! coordinate index of the eigenperiod
+    int const MT0;
+    // pi constant
+    double const Mpi;
+    //! denominators of the MD and RMS misfit (independent of the node)
+    kernel::MisfitSums Mnorms;
+    //! shared bound of the pruning (0 if disabled)
+    TopKThreshold* Mpruning;
+    //! verbosity flag
+    bool Mverbose;
+
+}; // class ModelApplication
+
+/* -------------------------------------------------------------------------- */
+/*!
+ * \a liboptimizexx parameter space visitor computing the RMS misfit of both
+ * the linear and the nonlinear model from the Gram matrix of the regressors.
+ *
+ * The regressors of the Gram matrix must be passed in the order
+ * \f$\ddot{y}, \dot{y}, y, f_0, \ldots, f_{k-1}, \ddot{u}\f$ where
+ * \f$f_i\f$ are the regressors of the nonlinear terms of the model (e.g.
+ * \f$y^2, y^3\f$ for the cubic model).
+ * The cost of a node does not depend on the number of samples anymore.
+ *
+ * Since the MD misfit cannot be computed from inner products it is set to
+ * \c NaN. Use LinApplication or NonLinApplication to compute it for
+ * selected nodes.
+ */
+class GramApplication :
+  public opt::ParameterSpaceVisitor<TcoordType, TresultType>
+{
+  public:
+    //! constructor
+    GramApplication(GramMatrix const& gram, CoordinateMap const& coordinates,
+        int terms, bool verbose=false);
+    //! Visit function for a liboptimizexx grid.
+    /*!
+     * Does nothing by default.
+     * Since a grid has no coordinates the body of this function is empty.
+     *
+     * \param grid Grid to be visited.
+     */
+    virtual void operator()(opt::Grid<TcoordType, TresultType>* grid) { }
+    //! Visit function / application for a liboptimizexx node.
+    /*!
+     * Computes the \f$RMS\f$ error as follows:
+     * \f[
+     *    RMS = \sqrt{\frac{c^TGc}{\sum_{l=1}^N\ddot{u}_l^2}}
+     * \f]
+     * where \f$c\f$ is the coefficient vector of the parameter
+     * configuration and \f$G\f$ the Gram matrix.
+     *
+     * \param node Node to be visited.
+     */
+    virtual void operator()(opt::Node<TcoordType, TresultType>* node);
+  private:
+    //! maximum number of regressors
+    static int const MmaxRegressors = 16;
+    //! Gram matrix of the regressors
+    GramMatrix const& Mgram;
+    //! coordinate indices of the coefficients of the nonlinear terms
+    std::vector<int> Mc;
+    //! coordinate index of the damping
+    int const Mh;
+    //! coordinate index of the eigenperiod
+    int const MT0;
+    // pi constant
+    double const Mpi;
+    //! verbosity flag
+    bool Mverbose;
+
+}; // class GramApplication
+
+/* -------------------------------------------------------------------------- */
+/*!
+ * \a liboptimizexx parameter space visitor profiling out the coefficients
+ * of the nonlinear terms (variable projection).
+ *
+ * Only the damping and the eigenperiod are gridded. For each node the
+ * coefficients \f$c_0, \ldots, c_{k-1}\f$ (and optionally the gain
+ * \f$g\f$ of the calibration signal) minimizing
+ * \f[
+ *    \sum_{l=1}^N\left(\ddot{y}_l+a_1\dot{y}_l+a_2y_l
+ *      +\sum_i c_if_{i,l}-g\ddot{u}_l\right)^2
+ * \f]
+ * are computed from the Gram matrix of the regressors. The regressors must
+ * be passed like to GramApplication. The optimal values are stored as
+ * parameters of the result.
+ *
+ * The MD misfit is computed from the time series if requested, otherwise
+ * it is set to \c NaN.
+ */
+class ProjectionApplication :
+  public opt::ParameterSpaceVisitor<TcoordType, TresultType>
+{
+  public:
+    /*!
+     * constructor
+     *
+     * \param gram Gram matrix of the regressors
+     * \param columns pointers to the first sample of the regressors the
+     * Gram matrix was computed from (used for the MD misfit only)
+     * \param n number of samples of the regressors
+     * \param coordinates coordinate indices of the unknown parameters
+     * \param terms number of nonlinear terms of the model
+     * \param gain flag if the gain of the calibration signal is profiled
+     * \param md flag if the MD misfit is computed from the time series
+     * \param verbose verbosity flag
+     */
+    ProjectionApplication(GramMatrix const& gram,
+        std::vector<double const*> const& columns, int n,
+        CoordinateMap const& coordinates, int terms, bool gain, bool md,
+        bool verbose=false);
+    //! Visit function for a liboptimizexx grid.
+    /*!
+     * Does nothing by default.
+     * Since a grid has no coordinates the body of this function is empty.
+     *
+     * \param grid Grid to be visited.
+     */
+    virtual void operator()(opt::Grid<TcoordType, TresultType>* grid) { }
+    //! Visit function / application for a liboptimizexx node.
+    /*!
+     * \param node Node to be visited.
+     */
+    virtual void operator()(opt::Node<TcoordType, TresultType>* node);
+  private:
+    //! maximum number of regressors
+    static int const MmaxRegressors = 16;
+    //! Gram matrix of the regressors
+    GramMatrix const& Mgram;
+    //! regressor time series
+    std::vector<double const*> Mcolumns;
+    //! number of samples
+    int Mn;
+    //! indices of the profiled coefficients
+    std::vector<int> Mfree;
+    //! flag if the gain is profiled
+    bool Mgain;
+    //! flag if the MD misfit is computed
+    bool Mmd;
+    //! denominator of the MD misfit
+    double MmdNorm;
+    //! coordinate index of the damping
+    int const Mh;
+    //! coordinate index of the eigenperiod
+    int const MT0;
     // pi constant
     double const Mpi;
     //! verbosity flag
     bool Mverbose;
 
-}; // class NonLinApplication
+}; // class ProjectionApplication
 
 #endif // include guard
 
@@ -34,6 +34,7 @@
 # 14/05/2012  V0.3  provide plotting legend and multiple files
 # 15/05/2012  V0.4  handle header line of datafile
 # 13/06/2012  V0.5  simple 2D representation availabel now
+# 16/10/2026  V0.6  read binary .npy DATAFILEs
 # 
 # =============================================================================
 """
@@ -53,7 +54,7 @@ from matplotlib import rc
 import matplotlib.pyplot as plt
 import numpy as np
 
-__version__ = "V0.5"
+__version__ = "V0.6"
 __subversion__ = "$Id$"
 __license__ = "GPLv2+"
 __author__ = "Daniel Armbruster"
@@ -134,7 +135,9 @@ def help():
  --legfontsize arg    Set the fontsize of legend text. (arg of int type)
  DATAFILE(s)          File(s) which contain(s) the data. Up to now plotting of
                       seven datasets is provided. Each DATAFILE must contain
-                      exactly one header line.\n"""
+                      exactly one header line. DATAFILEs with the suffix
+                      '.npy' are read as binary tables written with
+                      '--oformat npy'.\n"""
   Usage().display()
   sys.stdout.write(help_text)
 
@@ -268,6 +271,11 @@ def main(argv=None):
       if verbose:
         sys.stdout.write( \
             "optcaldibu: Reading file '{0}' ... \n".format(datafile))
+      if datafile.endswith(".npy"):
+        table = np.load(datafile, mmap_mode="r")
+        header = list(table.dtype.names)
+        all_data.append([list(table[name]) for name in header])
+        continue
       try:
         file = open(datafile, "r")
         lines = (line.split() for line in file)